@@ -0,0 +1,293 @@
+//
+// Program: JSONLib_Benchmarks
+//
+// Description: Benchmark JSON parse, stringify, strip and validate over a
+// corpus of document shapes produced by JSON_Generator and read from both
+// buffer and file sources. Each benchmark is run a number of warmup
+// iterations followed by timed repetitions and summarised as MB/s and
+// ns/node; results may also be written as JSON so that runs can be
+// compared.
+//
+// Usage: JSONLib_Benchmarks [--size bytes] [--warmup count]
+//                           [--repetitions count] [--filter text]
+//                           [--seed number] [--json file]
+//
+// Note: Configure with -DCMAKE_BUILD_TYPE=Release for meaningful figures.
+//
+// Dependencies: C20++, JSONLib.
+//
+// =============
+// INCLUDE FILES
+// =============
+// =======
+// C++ STL
+// =======
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+// ====
+// JSON
+// ====
+#include "JSON.hpp"
+#include "JSON_Destinations.hpp"
+#include "JSON_Generator.hpp"
+#include "JSON_Sources.hpp"
+#include "JSON_Writer.hpp"
+// ====================
+// JSON class namespace
+// ====================
+using namespace JSONLib;
+// ========================
+// LOCAL TYPES/DEFINITIONS
+// ========================
+// Benchmark options
+struct Options {
+  std::size_t size{1024 * 1024};
+  int warmup{2};
+  int repetitions{10};
+  std::uint64_t seed{JSON_Generator::kDefaultSeed};
+  std::string filter;
+  std::string jsonFileName;
+};
+// Summary of timed repetitions (nanoseconds)
+struct Statistics {
+  double minimum{};
+  double median{};
+  double mean{};
+  double deviation{};
+};
+// Result of a single benchmark
+struct Result {
+  std::string name;
+  std::size_t bytes{};
+  std::size_t nodes{};
+  Statistics time;
+};
+// Corpus file removed when it goes out of scope (even if a benchmark throws)
+struct TemporaryFile {
+  explicit TemporaryFile(std::string fileName) : name(std::move(fileName)) {}
+  TemporaryFile(const TemporaryFile &other) = delete;
+  TemporaryFile &operator=(const TemporaryFile &other) = delete;
+  ~TemporaryFile() {
+    std::error_code error;
+    std::filesystem::remove(name, error);
+  }
+  const std::string name;
+};
+// ===============
+// LOCAL FUNCTIONS
+// ===============
+/// <summary>
+/// Count the nodes in a JNode tree (packed array values count as nodes).
+/// </summary>
+/// <param name="jNode">Root of JNode tree.</param>
+/// <returns>Number of nodes.</returns>
+static std::size_t countNodes(const JNode &jNode) {
+  std::size_t nodes{1};
+  if (jNode.getNodeType() == JNodeType::object) {
+    for (auto &entry : JNodeRef<JNodeObject>(jNode).objects()) {
+      nodes += countNodes(*entry.value);
+    }
+  } else if (jNode.getNodeType() == JNodeType::array &&
+             JNodeRef<JNodeArray>(jNode).packing() !=
+                 JNodeArray::Packing::none) {
+    nodes += JNodeRef<JNodeArray>(jNode).size();
+  } else if (jNode.getNodeType() == JNodeType::array) {
+    for (auto &entry : JNodeRef<JNodeArray>(jNode).array()) {
+      nodes += countNodes(*entry);
+    }
+  }
+  return (nodes);
+}
+/// <summary>
+/// Time warmup plus repeated runs of a benchmark and summarise them.
+/// </summary>
+/// <param name="options">Benchmark options.</param>
+/// <param name="benchmark">Benchmark to run.</param>
+/// <returns>Timing statistics.</returns>
+static Statistics measure(const Options &options,
+                          const std::function<void()> &benchmark) {
+  for (int warmup = 0; warmup < options.warmup; warmup++) {
+    benchmark();
+  }
+  std::vector<double> times;
+  for (int repetition = 0; repetition < options.repetitions; repetition++) {
+    const auto start = std::chrono::steady_clock::now();
+    benchmark();
+    const auto stop = std::chrono::steady_clock::now();
+    times.push_back(
+        std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::sort(times.begin(), times.end());
+  Statistics statistics;
+  statistics.minimum = times.front();
+  statistics.median = times.size() % 2 == 1
+                          ? times[times.size() / 2]
+                          : (times[times.size() / 2 - 1] +
+                             times[times.size() / 2]) /
+                                2;
+  statistics.mean =
+      std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+  double variance{};
+  for (auto time : times) {
+    variance += (time - statistics.mean) * (time - statistics.mean);
+  }
+  statistics.deviation = std::sqrt(variance / times.size());
+  return (statistics);
+}
+/// <summary>
+/// Display a benchmark result.
+/// </summary>
+/// <param name="result">Benchmark result.</param>
+static void display(const Result &result) {
+  std::cout << std::left << std::setw(32) << result.name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10)
+            << result.bytes / result.time.median * 1000.0 << " MB/s"
+            << std::setw(10) << result.time.median / result.nodes
+            << " ns/node" << std::setw(12) << result.time.median / 1000.0
+            << " us +/- " << std::setprecision(1)
+            << result.time.deviation / result.time.median * 100.0 << "%\n";
+}
+/// <summary>
+/// Write benchmark results as JSON.
+/// </summary>
+/// <param name="options">Benchmark options.</param>
+/// <param name="results">Benchmark results.</param>
+static void writeResults(const Options &options,
+                         const std::vector<Result> &results) {
+  FileDestination destination{options.jsonFileName};
+  JSONWriter writer{destination};
+  writer.beginObject()
+      .member("version", JSON().version())
+      .member("size", static_cast<long long>(options.size))
+      .member("warmup", options.warmup)
+      .member("repetitions", options.repetitions)
+      .member("seed", static_cast<long long>(options.seed))
+      .key("results")
+      .beginArray();
+  for (auto &result : results) {
+    writer.beginObject()
+        .member("name", result.name)
+        .member("bytes", static_cast<long long>(result.bytes))
+        .member("nodes", static_cast<long long>(result.nodes))
+        .member("minimumNs", result.time.minimum)
+        .member("medianNs", result.time.median)
+        .member("meanNs", result.time.mean)
+        .member("deviationNs", result.time.deviation)
+        .member("mbPerSecond", result.bytes / result.time.median * 1000.0)
+        .member("nsPerNode", result.time.median / result.nodes)
+        .endObject();
+  }
+  writer.endArray().endObject();
+  writer.flush();
+}
+/// <summary>
+/// Process command line options.
+/// </summary>
+/// <param name="argc">Argument count.</param>
+/// <param name="argv">Argument list.</param>
+/// <returns>Benchmark options.</returns>
+static Options processOptions(int argc, char **argv) {
+  Options options;
+  for (int argument = 1; argument < argc; argument++) {
+    const std::string option{argv[argument]};
+    if (argument + 1 >= argc) {
+      throw std::runtime_error("Missing value for option " + option + ".");
+    }
+    const std::string value{argv[++argument]};
+    if (option == "--size") {
+      options.size = std::stoull(value);
+    } else if (option == "--warmup") {
+      options.warmup = std::stoi(value);
+    } else if (option == "--repetitions") {
+      options.repetitions = std::max(1, std::stoi(value));
+    } else if (option == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (option == "--filter") {
+      options.filter = value;
+    } else if (option == "--json") {
+      options.jsonFileName = value;
+    } else {
+      throw std::runtime_error("Unknown option " + option + ".");
+    }
+  }
+  return (options);
+}
+// ============================
+// ===== MAIN ENTRY POINT =====
+// ============================
+int main(int argc, char **argv) {
+  try {
+    const Options options{processOptions(argc, argv)};
+    std::vector<Result> results;
+    auto run = [&](const std::string &name, std::size_t bytes,
+                   std::size_t nodes, const std::function<void()> &benchmark) {
+      if (name.find(options.filter) == std::string::npos) {
+        return;
+      }
+      results.push_back(
+          Result{name, bytes, nodes, measure(options, benchmark)});
+      display(results.back());
+    };
+    for (auto generatorShape : JSON_Generator::shapes()) {
+      const std::string shape{JSON_Generator::name(generatorShape)};
+      const std::string jsonText{
+          JSON_Generator{generatorShape, options.seed}.generate(options.size)};
+      const TemporaryFile corpus{(std::filesystem::temp_directory_path() /
+                                  ("JSONLib_Benchmark_" + shape + ".json"))
+                                     .string()};
+      const std::string &fileName{corpus.name};
+      FileDestination{fileName}.add(jsonText);
+      const JSON json;
+      json.parse(BufferSource{jsonText});
+      const std::size_t nodes{countNodes(json.root())};
+      const std::size_t bytes{jsonText.size()};
+      run(shape + "/parse/buffer", bytes, nodes,
+          [&] { JSON().parse(BufferSource{jsonText}); });
+      run(shape + "/parse/file", bytes, nodes,
+          [&] { JSON().parse(FileSource{fileName}); });
+      run(shape + "/stringify/buffer", bytes, nodes, [&] {
+        BufferDestination destination;
+        json.stringify(destination);
+      });
+      run(shape + "/strip/buffer", bytes, nodes, [&] {
+        BufferDestination destination;
+        json.strip(BufferSource{jsonText}, destination);
+      });
+      run(shape + "/validate/buffer", bytes, nodes, [&] {
+        if (!json.validate(BufferSource{jsonText})) {
+          throw std::runtime_error("Invalid benchmark document.");
+        }
+      });
+      run(shape + "/validate/file", bytes, nodes, [&] {
+        [[maybe_unused]] auto valid = json.validate(FileSource{fileName});
+      });
+    }
+    // A long string is escaped in place into space prepared at the end of
+    // the buffer, so this shows the cost of preparing (and any filling of)
+    // that space. The buffer is reused so it is not grown each repetition.
+    const std::string longString(options.size, 'x');
+    BufferDestination written{options.size + 2};
+    run("string/write/buffer", longString.size(), 1, [&] {
+      written.clear();
+      JSONWriter{written}.value(longString);
+    });
+    if (!options.jsonFileName.empty()) {
+      writeResults(options, results);
+    }
+  } catch (const std::exception &ex) {
+    std::cerr << ex.what() << "\n";
+    exit(EXIT_FAILURE);
+  }
+  exit(EXIT_SUCCESS);
+}
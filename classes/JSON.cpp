@@ -19,6 +19,8 @@
 // =================
 #include "JSON.hpp"
 #include "JSON_Impl.hpp"
+#include "JSON_JNodeReclaimer.hpp"
+#include "JSON_WorkStealingPool.hpp"
 // ====================
 // CLASS IMPLEMENTATION
 // ====================
@@ -45,14 +47,18 @@ namespace JSONLib {
 // PUBLIC METHODS
 // ==============
 /// <summary>
-/// JSON constructor. Pass any custom converter or translator here.
+/// JSON constructor. Pass any custom converter, translator or memory
+/// resource (used for all JNode tree allocations) here.
 /// </summary>
 /// <param name="translator">Pointer to translator interface.</param>
 /// <param name="converter">Pointer to converter interface.</param>
-JSON::JSON(ITranslator *translator, IConverter *converter)
+/// <param name="resource">Pointer to memory resource.</param>
+JSON::JSON(ITranslator *translator, IConverter *converter,
+           std::pmr::memory_resource *resource)
     : m_jsonImplementation(std::make_unique<JSON_Impl>()) {
   m_jsonImplementation->converter(converter);
   m_jsonImplementation->translator(translator);
+  m_jsonImplementation->resource(resource);
 }
 /// <summary>
 /// JSON constructor. Pass a JSON string to be initially parsed.
@@ -95,6 +101,50 @@ void JSON::parse(ISource &&source) const {
   m_jsonImplementation->parse(source);
 }
 /// <summary>
+/// Check that the source contains valid JSON without building a JNode
+/// tree; returns the offset and message of the first error found.
+/// </summary>
+/// <param name="source">Source for JSON encoded bytes.</param>
+/// <returns>Validation result.</returns>
+JSON::ValidationResult JSON::validate(ISource &source) const {
+  return (m_jsonImplementation->validate(source));
+}
+JSON::ValidationResult JSON::validate(ISource &&source) const {
+  return (m_jsonImplementation->validate(source));
+}
+/// <summary>
+/// Parse a batch of independent JSON sources on the library work stealing
+/// thread pool. Each document is allocated from its own arena (owned by the
+/// returned JSON object) so that parsing threads do not contend on the
+/// global allocator; re-parsing a returned object replaces its arena rather
+/// than growing it. Results are returned in the same order as the sources,
+/// one per source; a source that fails to parse does not affect the others
+/// and its result holds the exception thrown (and its message) instead.
+/// </summary>
+/// <param name="sources">Sources of JSON encoded bytes.</param>
+/// <returns>Parsed JSON objects or errors.</returns>
+std::vector<JSON::BatchResult>
+JSON::parseBatch(std::span<ISource *const> sources) {
+  std::vector<BatchResult> results(sources.size());
+  JSON_WorkStealingPool::instance().run(
+      sources.size(), [&](std::size_t index) {
+        auto &result = results[index];
+        try {
+          auto json = std::make_unique<JSON>();
+          json->m_jsonImplementation->arena();
+          json->m_jsonImplementation->parse(*sources[index]);
+          result.json = std::move(json);
+        } catch (const std::exception &ex) {
+          result.error = std::current_exception();
+          result.message = ex.what();
+        } catch (...) {
+          result.error = std::current_exception();
+          result.message = "Unknown error.";
+        }
+      });
+  return (results);
+}
+/// <summary>
 /// Traverse JNode structure and build its JSON text in destination stream.
 /// </summary>
 /// <param name=destination>Destination stream for stringified JSON.</param>
@@ -105,6 +155,41 @@ void JSON::stringify(IDestination &&destination) const {
   m_jsonImplementation->stringify(destination);
 }
 /// <summary>
+/// Traverse JNode structure and build its JSON text in destination stream
+/// stringifying the entries of a large root object/array in parallel. With a
+/// custom translator or converter (which need not be thread safe) it is
+/// stringified serially.
+/// </summary>
+/// <param name=destination>Destination stream for stringified JSON.</param>
+void JSON::stringifyParallel(IDestination &destination) const {
+  m_jsonImplementation->stringifyParallel(destination);
+}
+void JSON::stringifyParallel(IDestination &&destination) const {
+  m_jsonImplementation->stringifyParallel(destination);
+}
+/// <summary>
+/// Create JNode structure from its binary encoding (as produced by
+/// stringifyBinary()) on the source stream.
+/// </summary>
+/// <param name="source">Source for binary encoded bytes.</param>
+void JSON::parseBinary(ISource &source) const {
+  m_jsonImplementation->parseBinary(source);
+}
+void JSON::parseBinary(ISource &&source) const {
+  m_jsonImplementation->parseBinary(source);
+}
+/// <summary>
+/// Traverse JNode structure and write its binary encoding to destination
+/// stream; this can be reloaded with parseBinary() without any text parsing.
+/// </summary>
+/// <param name=destination>Destination stream for binary encoding.</param>
+void JSON::stringifyBinary(IDestination &destination) const {
+  m_jsonImplementation->stringifyBinary(destination);
+}
+void JSON::stringifyBinary(IDestination &&destination) const {
+  m_jsonImplementation->stringifyBinary(destination);
+}
+/// <summary>
 /// Return object entry for the passed in key.
 /// </summary>
 /// <param name=destination>Object entry (JNode) key.</param>
@@ -114,7 +199,7 @@ JNode &JSON::operator[](const std::string &key) {
 }
 const JNode &JSON::operator[](const std::string &key) const // Object
 {
-  return ((*m_jsonImplementation)[key]);
+  return (std::as_const(*m_jsonImplementation)[key]);
 }
 /// <summary>
 /// Return array entry for the passed in index.
@@ -124,9 +209,44 @@ JNode &JSON::operator[](std::size_t index) {
   return ((*m_jsonImplementation)[index]);
 }
 const JNode &JSON::operator[](std::size_t index) const {
-  return ((*m_jsonImplementation)[index]);
+  return (std::as_const(*m_jsonImplementation)[index]);
+}
+/// <summary>
+/// Enable/disable destroying old JNode trees on a background thread. Only
+/// trees allocated from a resource that may be used from several threads
+/// at once (new/delete, the default resource or a synchronized pool) are
+/// deferred; any other tree is still destroyed on the calling thread.
+/// </summary>
+/// <param name="deferDestruction">==true then defer destruction.</param>
+void JSON::deferDestruction(bool deferDestruction) const {
+  m_jsonImplementation->deferDestruction(deferDestruction);
+}
+/// <summary>
+/// Return a snapshot of the parse/stringify statistics gathered so far
+/// (enabled is false and all counts zero if statistics were turned off
+/// when built). Stringify may be run on several threads at once and still
+/// be counted.
+/// </summary>
+/// <returns>Statistics.</returns>
+JSON::Statistics JSON::stats() const {
+  return (m_jsonImplementation->stats());
+}
+/// <summary>
+/// Return the bytes allocated for the JNode tree broken down by use.
+/// </summary>
+/// <returns>Memory usage (all zero if there is no tree).</returns>
+JSON::MemoryUsage JSON::memoryUsage() const {
+  return (m_jsonImplementation->memoryUsage());
 }
 /// <summary>
+/// Reset parse/stringify statistics.
+/// </summary>
+void JSON::resetStats() const { m_jsonImplementation->resetStats(); }
+/// <summary>
+/// Wait until all deferred JNode tree destruction has completed.
+/// </summary>
+void JSON::flushDestruction() { JNodeReclaimer::instance().flush(); }
+/// <summary>
 /// Return root of JSON tree.
 /// </summary>
 /// <returns>Root of JSON tree,</returns>
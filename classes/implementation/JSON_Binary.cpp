@@ -0,0 +1,420 @@
+//
+// Class: JSON_Binary
+//
+// Description: Compact binary encoding of a JNode tree. Every node starts
+// with a type tag and every string/container with its length so that a
+// tree can be reloaded without scanning text, translating escapes or
+// parsing numbers. Numbers keep their exact JNodeNumeric type and packed
+// arrays are written as their raw values and decoded back into packed
+// arrays.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_Binary.hpp"
+// =======
+// C++ STL
+// =======
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <span>
+#include <type_traits>
+#include <vector>
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// Largest string read in one go (longer ones are read in chunks so that a
+// corrupt length cannot cause a huge allocation up front)
+constexpr std::uint64_t kMaxChunk{64 * 1024};
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Add a tag byte to destination.
+/// </summary>
+/// <param name="tag">Node tag.</param>
+/// <param name="destination">Destination for encoding.</param>
+static void addTag(JSON_Binary::Tag tag, IDestination &destination) {
+  destination.add(static_cast<char>(tag));
+}
+/// <summary>
+/// Add an unsigned LEB128 encoded integer to destination.
+/// </summary>
+/// <param name="value">Value to encode.</param>
+/// <param name="destination">Destination for encoding.</param>
+static void addLength(std::uint64_t value, IDestination &destination) {
+  std::array<char, 10> bytes;
+  std::size_t length{};
+  do {
+    bytes[length++] =
+        static_cast<char>((value & 0x7F) | (value > 0x7F ? 0x80 : 0));
+    value >>= 7;
+  } while (value != 0);
+  destination.add(bytes.data(), length);
+}
+/// <summary>
+/// Add a fixed size unsigned integer to destination (little endian).
+/// </summary>
+/// <param name="value">Value to encode.</param>
+/// <param name="destination">Destination for encoding.</param>
+template <typename T> static void addFixed(T value, IDestination &destination) {
+  std::array<char, sizeof(T)> bytes;
+  for (auto &byte : bytes) {
+    byte = static_cast<char>(value & 0xFF);
+    value >>= 8;
+  }
+  destination.add(bytes.data(), bytes.size());
+}
+/// <summary>
+/// Add a length prefixed run of bytes to destination.
+/// </summary>
+/// <param name="bytes">Bytes to encode.</param>
+/// <param name="destination">Destination for encoding.</param>
+static void addBytes(const std::string_view &bytes, IDestination &destination) {
+  addLength(bytes.size(), destination);
+  destination.add(bytes.data(), bytes.size());
+}
+/// <summary>
+/// Return a value with its bytes reversed.
+/// </summary>
+/// <param name="value">Value to reverse.</param>
+/// <returns>Value with bytes reversed.</returns>
+template <typename T> static T reverseBytes(T value) {
+  auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+  std::ranges::reverse(bytes);
+  return (std::bit_cast<T>(bytes));
+}
+/// <summary>
+/// Add a packed array as a tag, count and its values (little endian).
+/// </summary>
+/// <param name="tag">Packed array tag.</param>
+/// <param name="values">Packed values.</param>
+/// <param name="destination">Destination for encoding.</param>
+template <typename T>
+static void addPacked(JSON_Binary::Tag tag, std::span<const T> values,
+                      IDestination &destination) {
+  addTag(tag, destination);
+  addLength(values.size(), destination);
+  if constexpr (std::endian::native == std::endian::little) {
+    destination.add(reinterpret_cast<const char *>(values.data()),
+                    values.size_bytes());
+  } else {
+    for (const auto value : values) {
+      const auto reversed = reverseBytes(value);
+      destination.add(reinterpret_cast<const char *>(&reversed),
+                      sizeof(reversed));
+    }
+  }
+}
+/// <summary>
+/// Read exactly length bytes from source.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <param name="bytes">Buffer for bytes.</param>
+/// <param name="length">Number of bytes.</param>
+static void readBytes(ISource &source, char *bytes, std::size_t length) {
+  if (source.read(bytes, length) != length) {
+    throw JSON_Binary::Error("Unexpected end of encoding.");
+  }
+}
+/// <summary>
+/// Read a tag/single byte from source.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <returns>Byte read.</returns>
+static char readByte(ISource &source) {
+  char byte;
+  readBytes(source, &byte, 1);
+  return (byte);
+}
+/// <summary>
+/// Read an unsigned LEB128 encoded integer from source.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <returns>Decoded value.</returns>
+static std::uint64_t readLength(ISource &source) {
+  std::uint64_t value{};
+  for (int shift = 0; shift < 64; shift += 7) {
+    const auto byte = static_cast<unsigned char>(readByte(source));
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return (value);
+    }
+  }
+  throw JSON_Binary::Error("Invalid length.");
+}
+/// <summary>
+/// Read a fixed size unsigned integer from source (little endian).
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <returns>Decoded value.</returns>
+template <typename T> static T readFixed(ISource &source) {
+  std::array<char, sizeof(T)> bytes;
+  readBytes(source, bytes.data(), bytes.size());
+  T value{};
+  for (auto byte = bytes.rbegin(); byte != bytes.rend(); byte++) {
+    value = static_cast<T>((value << 8) | static_cast<unsigned char>(*byte));
+  }
+  return (value);
+}
+/// <summary>
+/// Read a length prefixed string from source into a string allocated from
+/// the passed memory resource.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <param name="resource">Memory resource for string.</param>
+/// <returns>Decoded string.</returns>
+static std::pmr::string readString(ISource &source,
+                                   std::pmr::memory_resource *resource) {
+  std::pmr::string string{resource};
+  for (std::uint64_t remaining = readLength(source); remaining != 0;) {
+    const auto chunk = static_cast<std::size_t>(std::min(remaining, kMaxChunk));
+    const std::size_t size = string.size();
+    string.resize(size + chunk);
+    readBytes(source, &string[size], chunk);
+    remaining -= chunk;
+  }
+  return (string);
+}
+/// <summary>
+/// Read the count and values of a packed array from source into a packed
+/// array allocated from the passed memory resource. Values are read in
+/// chunks so that a corrupt count cannot cause a huge allocation up front.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <param name="resource">Memory resource for array.</param>
+/// <returns>Packed array JNode.</returns>
+template <typename T>
+static JNode::Ptr readPacked(ISource &source,
+                             std::pmr::memory_resource *resource) {
+  std::vector<T> values;
+  for (std::uint64_t remaining = readLength(source); remaining != 0;) {
+    const auto chunk = static_cast<std::size_t>(
+        std::min(remaining, kMaxChunk / sizeof(T)));
+    const std::size_t size = values.size();
+    values.resize(size + chunk);
+    readBytes(source, reinterpret_cast<char *>(values.data() + size),
+              chunk * sizeof(T));
+    remaining -= chunk;
+  }
+  if constexpr (std::endian::native != std::endian::little) {
+    for (auto &value : values) {
+      value = reverseBytes(value);
+    }
+  }
+  return (makeJNode(JNodeArray{std::span<const T>{values}, resource},
+                    resource));
+}
+/// <summary>
+/// Recursively encode a JNode tree.
+/// </summary>
+/// <param name="jNode">JNode to encode.</param>
+/// <param name="destination">Destination for encoding.</param>
+void JSON_Binary::encodeJNodes(const JNode &jNode, IDestination &destination) {
+  switch (jNode.getNodeType()) {
+  case JNodeType::object: {
+    const auto &objects = JNodeRef<JNodeObject>(jNode).objects();
+    addTag(Tag::object, destination);
+    addLength(objects.size(), destination);
+    for (auto &[key, jNodePtr] : objects) {
+      addBytes(key, destination);
+      encodeJNodes(*jNodePtr, destination);
+    }
+    break;
+  }
+  case JNodeType::array: {
+    const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+    if (jNodeArray.packing() == JNodeArray::Packing::integer) {
+      addPacked(Tag::integerArray, jNodeArray.integers(), destination);
+      break;
+    }
+    if (jNodeArray.packing() == JNodeArray::Packing::floatingPoint32) {
+      addPacked(Tag::floatingPointArray, jNodeArray.floatingPoints32(),
+                destination);
+      break;
+    }
+    if (jNodeArray.packing() == JNodeArray::Packing::floatingPoint) {
+      addPacked(Tag::doubleFloatingPointArray, jNodeArray.floatingPoints(),
+                destination);
+      break;
+    }
+    const auto &array = jNodeArray.array();
+    addTag(Tag::array, destination);
+    addLength(array.size(), destination);
+    for (auto &jNodePtr : array) {
+      encodeJNodes(*jNodePtr, destination);
+    }
+    break;
+  }
+  case JNodeType::string:
+    addTag(Tag::string, destination);
+    addBytes(JNodeRef<JNodeString>(jNode).string(), destination);
+    break;
+  case JNodeType::number:
+    encodeNumber(JNodeRef<JNodeNumber>(jNode).number(), destination);
+    break;
+  case JNodeType::boolean:
+    addTag(JNodeRef<JNodeBoolean>(jNode).boolean() ? Tag::booleanTrue
+                                                   : Tag::booleanFalse,
+           destination);
+    break;
+  default:
+    addTag(Tag::null, destination);
+  }
+}
+/// <summary>
+/// Encode a number (keeping its exact type).
+/// </summary>
+/// <param name="number">Number to encode.</param>
+/// <param name="destination">Destination for encoding.</param>
+void JSON_Binary::encodeNumber(const JNodeNumeric &number,
+                               IDestination &destination) {
+  if (number.isInt()) {
+    addTag(Tag::integer, destination);
+    addFixed(static_cast<std::uint32_t>(number.getInt()), destination);
+  } else if (number.isLong()) {
+    addTag(Tag::longInteger, destination);
+    addFixed(static_cast<std::uint64_t>(number.getLong()), destination);
+  } else if (number.isLLong()) {
+    addTag(Tag::llong, destination);
+    addFixed(static_cast<std::uint64_t>(number.getLLong()), destination);
+  } else if (number.isFloat()) {
+    addTag(Tag::floatingPoint, destination);
+    addFixed(std::bit_cast<std::uint32_t>(number.getFloat()), destination);
+  } else if (number.isDouble()) {
+    addTag(Tag::doubleFloatingPoint, destination);
+    addFixed(std::bit_cast<std::uint64_t>(number.getDouble()), destination);
+  } else {
+    // Long double layout varies between platforms so is held as text
+    addTag(Tag::ldouble, destination);
+    addBytes(number.getString(), destination);
+  }
+}
+/// <summary>
+/// Recursively decode a JNode tree.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <param name="resource">Memory resource for JNode tree.</param>
+/// <returns>Decoded JNode tree.</returns>
+JNode::Ptr JSON_Binary::decodeJNodes(ISource &source,
+                                     std::pmr::memory_resource *resource) {
+  switch (static_cast<Tag>(readByte(source))) {
+  case Tag::object: {
+    const std::uint64_t count = readLength(source);
+    JNodeObject::ObjectList objects{resource};
+    objects.reserve(static_cast<std::size_t>(std::min(count, kMaxChunk)));
+    for (std::uint64_t entry = 0; entry < count; entry++) {
+      auto key = readString(source, resource);
+      objects.emplace_back(JNodeObject::ObjectEntry{
+          std::move(key), decodeJNodes(source, resource)});
+    }
+    return (makeObject(objects, resource));
+  }
+  case Tag::array: {
+    const std::uint64_t count = readLength(source);
+    JNodeArray::ArrayList array{resource};
+    array.reserve(static_cast<std::size_t>(std::min(count, kMaxChunk)));
+    for (std::uint64_t entry = 0; entry < count; entry++) {
+      array.emplace_back(decodeJNodes(source, resource));
+    }
+    return (makeArray(array, resource));
+  }
+  case Tag::integerArray:
+    return (readPacked<std::int64_t>(source, resource));
+  case Tag::floatingPointArray:
+    return (readPacked<float>(source, resource));
+  case Tag::doubleFloatingPointArray:
+    return (readPacked<double>(source, resource));
+  case Tag::string: {
+    // Same resource so the decoded string is moved in without a copy
+    JNodeString string{"", resource};
+    string.string() = readString(source, resource);
+    return (makeJNode(std::move(string), resource));
+  }
+  case Tag::integer:
+    return (makeNumber(
+        JNodeNumeric{static_cast<int>(readFixed<std::uint32_t>(source))},
+        resource));
+  case Tag::longInteger:
+    return (makeNumber(
+        JNodeNumeric{static_cast<long>(readFixed<std::uint64_t>(source))},
+        resource));
+  case Tag::llong:
+    return (makeNumber(
+        JNodeNumeric{static_cast<long long>(readFixed<std::uint64_t>(source))},
+        resource));
+  case Tag::floatingPoint:
+    return (makeNumber(
+        JNodeNumeric{std::bit_cast<float>(readFixed<std::uint32_t>(source))},
+        resource));
+  case Tag::doubleFloatingPoint:
+    return (makeNumber(
+        JNodeNumeric{std::bit_cast<double>(readFixed<std::uint64_t>(source))},
+        resource));
+  case Tag::ldouble: {
+    const auto text = readString(source, resource);
+    long double value{};
+    if (std::from_chars(text.data(), text.data() + text.size(), value).ec !=
+        std::errc{}) {
+      throw Error("Invalid long double.");
+    }
+    return (makeNumber(JNodeNumeric{value}, resource));
+  }
+  case Tag::booleanTrue:
+    return (makeBoolean(true, resource));
+  case Tag::booleanFalse:
+    return (makeBoolean(false, resource));
+  case Tag::null:
+    return (makeNull(resource));
+  default:
+    throw Error("Invalid node tag.");
+  }
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// Encode a JNode tree to a destination.
+/// </summary>
+/// <param name="jNode">Root of JNode tree.</param>
+/// <param name="destination">Destination for encoding.</param>
+void JSON_Binary::encode(const JNode &jNode, IDestination &destination) {
+  destination.add(kMagic.data(), kMagic.size());
+  encodeJNodes(jNode, destination);
+}
+/// <summary>
+/// Decode a JNode tree from a source.
+/// </summary>
+/// <param name="source">Source of encoding.</param>
+/// <param name="resource">Memory resource for JNode tree.</param>
+/// <returns>Root of decoded JNode tree.</returns>
+JNode::Ptr JSON_Binary::decode(ISource &source,
+                               std::pmr::memory_resource *resource) {
+  std::array<char, kMagic.size()> magic;
+  if (source.read(magic.data(), magic.size()) != magic.size() ||
+      std::string_view{magic.data(), magic.size()} != kMagic) {
+    throw Error("Invalid header.");
+  }
+  return (decodeJNodes(source, resource));
+}
+} // namespace JSONLib
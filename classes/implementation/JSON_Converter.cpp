@@ -45,6 +45,7 @@ std::u16string JSON_Converter::toUtf16(const std::string &utf8) const {
                   static_cast<int>(wideString.length()));
   return (std::u16string{wideString.begin(), wideString.end()});
 #else
+  std::scoped_lock<std::mutex> lock(m_UTF16Mutex);
   return (m_UTF16.from_bytes(utf8));
 #endif
 }
@@ -58,6 +59,7 @@ std::string JSON_Converter::toUtf8(const std::u16string &utf16) const {
                   static_cast<int>(bytes.length()));
   return bytes;
 #else
+  std::scoped_lock<std::mutex> lock(m_UTF16Mutex);
   return (m_UTF16.to_bytes(utf16));
 #endif
 }
@@ -0,0 +1,348 @@
+//
+// Class: DocumentCache
+//
+// Description: Cache of parsed JSON documents keyed on file name and file
+// identity (inode, modification time and size). Documents are immutable
+// and shared so any number of threads may use one at once. Only one
+// thread loads a given file; any others asking for it wait on that load.
+// Least recently used documents are evicted to keep within a memory
+// budget. An optional background thread reloads documents whose files
+// have changed; while it runs cached documents are served without checking
+// their files and a reload is swapped in only once it has been parsed, so
+// callers neither stat the file nor wait on the reparse.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_DocumentCache.hpp"
+#include "JSON_ByteCountingResource.hpp"
+#include "JSON_Sources.hpp"
+// =======
+// C++ STL
+// =======
+#include <memory_resource>
+#include <vector>
+// ======
+// POSIX
+// ======
+#if defined(_WIN64)
+#include <filesystem>
+#else
+#include <sys/stat.h>
+#endif
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// ===================================================================
+// Cached document; its JNode tree is allocated from its own arena so
+// its size is known and it is released in one go on destruction.
+// ===================================================================
+struct CachedDocument {
+  ByteCountingResource counting;
+  std::pmr::monotonic_buffer_resource arena{&counting};
+  JSON json{nullptr, nullptr, &arena};
+};
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Parse a file into a new document.
+/// </summary>
+/// <param name="fileName">JSON file name.</param>
+/// <param name="bytes">Memory used by document.</param>
+/// <returns>Parsed document.</returns>
+DocumentCache::Document DocumentCache::load(const std::string &fileName,
+                                            std::size_t &bytes) {
+  auto cached = std::make_shared<CachedDocument>();
+  cached->json.parse(FileSource{fileName});
+  bytes = sizeof(CachedDocument) + cached->counting.allocated();
+  return (Document{cached, &cached->json.root()});
+}
+/// <summary>
+/// Record the result of a load against its entry (if it has not been
+/// replaced or evicted in the meantime) and evict as needed.
+/// </summary>
+/// <param name="fileName">JSON file name.</param>
+/// <param name="generation">Load generation.</param>
+/// <param name="bytes">Memory used by document.</param>
+/// <param name="failed">==true load failed.</param>
+void DocumentCache::loaded(const std::string &fileName,
+                           std::uint64_t generation, std::size_t bytes,
+                           bool failed) {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  auto entry = m_entries.find(fileName);
+  if (entry == m_entries.end() || entry->second.generation != generation) {
+    return;
+  }
+  if (failed) {
+    remove(entry);
+    return;
+  }
+  m_loads++;
+  entry->second.bytes = bytes;
+  m_memoryUsed += bytes;
+  evict();
+}
+/// <summary>
+/// Swap a document reloaded in the background into its entry (if it has
+/// not been replaced or evicted in the meantime) and evict as needed. The
+/// old document is released after the mutex (it may be the last user).
+/// </summary>
+/// <param name="fileName">JSON file name.</param>
+/// <param name="generation">Generation of the entry that was reloaded.</param>
+/// <param name="fileIdentity">Identity of the file reloaded.</param>
+/// <param name="document">Reloaded document.</param>
+/// <param name="bytes">Memory used by reloaded document.</param>
+void DocumentCache::reloaded(const std::string &fileName,
+                             std::uint64_t generation,
+                             const FileIdentity &fileIdentity,
+                             Document document, std::size_t bytes) {
+  std::promise<Document> promise;
+  promise.set_value(std::move(document));
+  std::shared_future<Document> replaced{promise.get_future().share()};
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  auto entry = m_entries.find(fileName);
+  if (entry == m_entries.end() || entry->second.generation != generation) {
+    return;
+  }
+  std::swap(entry->second.document, replaced);
+  entry->second.identity = fileIdentity;
+  entry->second.generation = ++m_generation;
+  m_memoryUsed = m_memoryUsed - entry->second.bytes + bytes;
+  entry->second.bytes = bytes;
+  m_loads++;
+  evict();
+}
+/// <summary>
+/// Return a cached entry's document, marking it most recently used. Called
+/// with mutex held, which is released before waiting on any load.
+/// </summary>
+/// <param name="entry">Cached entry.</param>
+/// <param name="lock">Lock held on mutex.</param>
+/// <returns>Parsed document.</returns>
+DocumentCache::Document
+DocumentCache::cached(Entry &entry, std::unique_lock<std::mutex> &lock) {
+  m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+  auto document = entry.document;
+  lock.unlock();
+  return (document.get());
+}
+/// <summary>
+/// Evict least recently used entries until within memory budget (the most
+/// recently used entry is always kept). Called with mutex held.
+/// </summary>
+void DocumentCache::evict() {
+  while (m_memoryUsed > m_memoryBudget && m_lru.size() > 1) {
+    remove(m_entries.find(m_lru.back()));
+  }
+}
+/// <summary>
+/// Remove an entry from the cache. Called with mutex held.
+/// </summary>
+/// <param name="entry">Entry to remove.</param>
+void DocumentCache::remove(
+    std::unordered_map<std::string, Entry>::iterator entry) {
+  m_memoryUsed -= entry->second.bytes;
+  m_lru.erase(entry->second.lru);
+  m_entries.erase(entry);
+}
+/// <summary>
+/// Revalidation thread; periodically reload any cached documents whose
+/// files have changed and drop those whose files have gone. The old
+/// document is served until its reload has been parsed and swapped in.
+/// </summary>
+void DocumentCache::revalidator() {
+  struct Revalidate {
+    std::string fileName;
+    FileIdentity identity;
+    std::uint64_t generation;
+  };
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stopChanged.wait_for(lock, m_revalidateInterval,
+                                 [this] { return (m_stop); })) {
+    std::vector<Revalidate> revalidate;
+    for (auto &[fileName, entry] : m_entries) {
+      if (entry.document.wait_for(std::chrono::seconds{0}) ==
+          std::future_status::ready) {
+        revalidate.push_back({fileName, entry.identity, entry.generation});
+      }
+    }
+    lock.unlock();
+    for (auto &[fileName, fileIdentity, generation] : revalidate) {
+      try {
+        const FileIdentity current = identity(fileName);
+        if (current != fileIdentity) {
+          std::size_t bytes{};
+          auto document = load(fileName, bytes);
+          reloaded(fileName, generation, current, std::move(document), bytes);
+        }
+      } catch ([[maybe_unused]] const std::exception &e) {
+        erase(fileName);
+      }
+    }
+    lock.lock();
+  }
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// Document cache constructor.
+/// </summary>
+/// <param name="memoryBudget">Memory budget for cached documents.</param>
+/// <param name="revalidateInterval">Interval between background
+/// revalidations (zero for none).</param>
+DocumentCache::DocumentCache(std::size_t memoryBudget,
+                             std::chrono::milliseconds revalidateInterval)
+    : m_memoryBudget(memoryBudget), m_revalidateInterval(revalidateInterval) {
+  if (m_revalidateInterval.count() > 0) {
+    m_thread = std::thread(&DocumentCache::revalidator, this);
+  }
+}
+/// <summary>
+/// Document cache destructor; stop any revalidation thread.
+/// </summary>
+DocumentCache::~DocumentCache() {
+  {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_stopChanged.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+/// <summary>
+/// Return the parsed document for a file, loading it if it is not cached
+/// or its file has changed since it was. With background revalidation a
+/// cached document is returned without checking its file.
+/// </summary>
+/// <param name="fileName">JSON file name.</param>
+/// <returns>Parsed document.</returns>
+DocumentCache::Document DocumentCache::get(const std::string &fileName) {
+  if (m_revalidateInterval.count() > 0) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto entry = m_entries.find(fileName);
+    if (entry != m_entries.end()) {
+      return (cached(entry->second, lock));
+    }
+  }
+  const FileIdentity fileIdentity = identity(fileName);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto entry = m_entries.find(fileName);
+  if (entry != m_entries.end()) {
+    if (entry->second.identity == fileIdentity) {
+      return (cached(entry->second, lock));
+    }
+    remove(entry);
+  }
+  std::promise<Document> promise;
+  auto document = promise.get_future().share();
+  const std::uint64_t generation = ++m_generation;
+  m_lru.push_front(fileName);
+  m_entries.emplace(fileName, Entry{fileIdentity, document, generation, 0,
+                                    m_lru.begin()});
+  lock.unlock();
+  try {
+    std::size_t bytes{};
+    auto loadedDocument = load(fileName, bytes);
+    loaded(fileName, generation, bytes, false);
+    promise.set_value(std::move(loadedDocument));
+  } catch (...) {
+    loaded(fileName, generation, 0, true);
+    promise.set_exception(std::current_exception());
+  }
+  return (document.get());
+}
+/// <summary>
+/// Remove any cached document for a file.
+/// </summary>
+/// <param name="fileName">JSON file name.</param>
+void DocumentCache::erase(const std::string &fileName) {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  auto entry = m_entries.find(fileName);
+  if (entry != m_entries.end()) {
+    remove(entry);
+  }
+}
+/// <summary>
+/// Remove all cached documents.
+/// </summary>
+void DocumentCache::clear() {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_lru.clear();
+  m_memoryUsed = 0;
+}
+/// <summary>
+/// Return number of cached documents.
+/// </summary>
+std::size_t DocumentCache::size() const {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  return (m_entries.size());
+}
+/// <summary>
+/// Return memory used by cached documents.
+/// </summary>
+std::size_t DocumentCache::memoryUsed() const {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  return (m_memoryUsed);
+}
+/// <summary>
+/// Return number of documents loaded.
+/// </summary>
+std::size_t DocumentCache::loads() const {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  return (m_loads);
+}
+/// <summary>
+/// Return identity of a file.
+/// </summary>
+/// <param name="fileName">File name.</param>
+/// <returns>File identity.</returns>
+DocumentCache::FileIdentity
+DocumentCache::identity(const std::string &fileName) {
+#if defined(_WIN64)
+  std::error_code error;
+  const auto modified = std::filesystem::last_write_time(fileName, error);
+  const auto size = std::filesystem::file_size(fileName, error);
+  if (error) {
+    throw Error("File does not exist.");
+  }
+  return (FileIdentity{0, modified.time_since_epoch().count(), size});
+#else
+  struct stat status {};
+  if (::stat(fileName.c_str(), &status) == -1) {
+    throw Error("File does not exist.");
+  }
+#if defined(__APPLE__)
+  const auto &modified = status.st_mtimespec;
+#else
+  const auto &modified = status.st_mtim;
+#endif
+  return (FileIdentity{
+      static_cast<std::uint64_t>(status.st_ino),
+      static_cast<std::int64_t>(modified.tv_sec) * 1000000000 +
+          modified.tv_nsec,
+      static_cast<std::uint64_t>(status.st_size)});
+#endif
+}
+} // namespace JSONLib
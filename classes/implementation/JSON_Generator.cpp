@@ -0,0 +1,303 @@
+//
+// Class: JSON_Generator
+//
+// Description: Deterministic synthetic JSON document generator. A document
+// of a given shape and approximate size (from a few KB up to many GB, as
+// it is streamed to its destination in chunks) is produced from a seed;
+// the same shape, size and seed always give the same bytes on every
+// platform as the library's own pseudo random number generator is used
+// rather than the implementation defined standard distributions.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_Generator.hpp"
+// =======
+// C++ STL
+// =======
+#include <array>
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// Shape names (same order as JSON_Generator::Shape)
+constexpr std::array<std::string_view, 5> kShapeNames{
+    "records", "numeric", "nested", "escapes", "wide"};
+// Vocabulary for generated text (includes multi-byte UTF-8 words)
+constexpr std::array<std::string_view, 24> kWords{
+    "the",     "quick",   "brown",  "fox",    "jumps",  "over",
+    "lazy",    "dog",     "json",   "parser", "stream", "buffer",
+    "café",    "naïve",   "résumé", "日本",   "München", "Ελλάδα",
+    "release", "latency", "cache",  "node",   "thread", "😀"};
+// Fragments for escape dense strings
+constexpr std::array<std::string_view, 10> kEscapes{
+    "\"quoted\"", "back\\slash", "tab\there", "new\nline", "\r\n",
+    "\x01\x02\x1f", "/path/to", "€uro",   "𝄞clef",    "plain"};
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Return next pseudo random number (xorshift64*).
+/// </summary>
+std::uint64_t JSON_Generator::next() {
+  m_state ^= m_state >> 12;
+  m_state ^= m_state << 25;
+  m_state ^= m_state >> 27;
+  return (m_state * 0x2545F4914F6CDD1DULL);
+}
+/// <summary>
+/// Return pseudo random number in range [0, range).
+/// </summary>
+/// <param name="range">Upper bound (exclusive).</param>
+std::uint64_t JSON_Generator::uniform(std::uint64_t range) {
+  return (next() % range);
+}
+/// <summary>
+/// Return pseudo random real in range [low, high).
+/// </summary>
+/// <param name="low">Lower bound.</param>
+/// <param name="high">Upper bound.</param>
+double JSON_Generator::real(double low, double high) {
+  return (low + (high - low) * static_cast<double>(next() >> 11) * 0x1.0p-53);
+}
+/// <summary>
+/// Return text made up of a number of random words.
+/// </summary>
+/// <param name="count">Number of words.</param>
+std::string JSON_Generator::words(std::size_t count) {
+  std::string text;
+  for (std::size_t word = 0; word < count; word++) {
+    if (word != 0) {
+      text += ' ';
+    }
+    text += kWords[uniform(kWords.size())];
+  }
+  return (text);
+}
+/// <summary>
+/// Return text dense in characters that need escaping.
+/// </summary>
+std::string JSON_Generator::escapes() {
+  std::string text;
+  for (auto count = 4 + uniform(12); count > 0; count--) {
+    text += kEscapes[uniform(kEscapes.size())];
+  }
+  return (text);
+}
+/// <summary>
+/// Add a string heavy record (modelled on a Twitter status).
+/// </summary>
+/// <param name="writer">JSON writer.</param>
+void JSON_Generator::addRecord(JSONWriter &writer) {
+  const auto id = static_cast<long long>(1000000000000 + m_entry);
+  const auto userId = static_cast<long long>(uniform(100000));
+  // Separate statements as operand evaluation order is unspecified
+  const auto day = std::to_string(1 + uniform(28));
+  const auto minute = std::to_string(10 + uniform(50));
+  writer.beginObject()
+      .member("id", id)
+      .member("id_str", std::to_string(id))
+      .member("created_at", "Mon Sep " + day + " 12:" + minute + ":00 +0000 2022")
+      .member("text", words(8 + uniform(16)))
+      .key("user")
+      .beginObject()
+      .member("id", userId)
+      .member("name", words(2))
+      .member("screen_name", "user_" + std::to_string(userId))
+      .member("location", words(1 + uniform(2)))
+      .member("followers_count", static_cast<int>(uniform(1000000)))
+      .member("verified", uniform(10) == 0)
+      .endObject()
+      .key("entities")
+      .beginObject()
+      .key("hashtags")
+      .beginArray();
+  for (auto count = uniform(4); count > 0; count--) {
+    writer.value(words(1));
+  }
+  writer.endArray()
+      .endObject()
+      .member("retweet_count", static_cast<int>(uniform(5000)))
+      .member("favorited", uniform(2) == 0)
+      .member("in_reply_to_status_id", nullptr)
+      .endObject();
+}
+/// <summary>
+/// Add a ring of coordinates (modelled on a GeoJSON polygon).
+/// </summary>
+/// <param name="writer">JSON writer.</param>
+void JSON_Generator::addCoordinates(JSONWriter &writer) {
+  writer.beginArray();
+  double longitude = real(-140.0, -50.0);
+  double latitude = real(42.0, 70.0);
+  for (auto count = 16 + uniform(48); count > 0; count--) {
+    longitude += real(-0.01, 0.01);
+    latitude += real(-0.01, 0.01);
+    writer.beginArray().value(longitude).value(latitude).endArray();
+  }
+  writer.endArray();
+}
+/// <summary>
+/// Add a nested configuration object.
+/// </summary>
+/// <param name="writer">JSON writer.</param>
+/// <param name="depth">Remaining nesting depth.</param>
+void JSON_Generator::addConfiguration(JSONWriter &writer, int depth) {
+  writer.beginObject()
+      .member("name", words(1))
+      .member("enabled", uniform(2) == 0)
+      .member("limit", static_cast<int>(uniform(65536)))
+      .member("ratio", real(0.0, 1.0));
+  if (depth > 0) {
+    writer.key("options").beginArray();
+    for (auto count = uniform(3); count > 0; count--) {
+      writer.value(words(1));
+    }
+    writer.endArray().key("child");
+    addConfiguration(writer, depth - 1);
+  }
+  writer.endObject();
+}
+/// <summary>
+/// Add the next entry of the document being generated.
+/// </summary>
+/// <param name="writer">JSON writer.</param>
+void JSON_Generator::addEntry(JSONWriter &writer) {
+  switch (m_shape) {
+  case Shape::records:
+    addRecord(writer);
+    break;
+  case Shape::numeric:
+    addCoordinates(writer);
+    break;
+  case Shape::nested:
+    addConfiguration(writer, 8 + static_cast<int>(uniform(24)));
+    break;
+  case Shape::escapes:
+    writer.value(escapes());
+    break;
+  case Shape::wide:
+    switch (uniform(4)) {
+    case 0:
+      writer.member("key" + std::to_string(m_entry), words(2));
+      break;
+    case 1:
+      writer.member("key" + std::to_string(m_entry),
+                    static_cast<long long>(next() >> 16));
+      break;
+    case 2:
+      writer.member("key" + std::to_string(m_entry), real(-1e6, 1e6));
+      break;
+    default:
+      writer.member("key" + std::to_string(m_entry), uniform(2) == 0);
+    }
+    break;
+  }
+  m_entry++;
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// JSON generator constructor.
+/// </summary>
+/// <param name="shape">Shape of documents to generate.</param>
+/// <param name="seed">Pseudo random number generator seed.</param>
+JSON_Generator::JSON_Generator(Shape shape, std::uint64_t seed)
+    : m_shape(shape), m_state(seed != 0 ? seed : kDefaultSeed) {}
+/// <summary>
+/// Generate a document of at least size bytes (the final entry and closing
+/// bracket take it slightly over) and write it to a destination.
+/// </summary>
+/// <param name="size">Document size in bytes.</param>
+/// <param name="destination">Destination for document.</param>
+/// <returns>Actual document size in bytes.</returns>
+std::uint64_t JSON_Generator::generate(std::uint64_t size,
+                                       IDestination &destination) {
+  std::uint64_t written{};
+  m_chunk.clear();
+  JSONWriter writer{m_chunk};
+  if (m_shape == Shape::wide) {
+    writer.beginObject();
+  } else {
+    writer.beginArray();
+  }
+  while (written + m_chunk.size() < size) {
+    addEntry(writer);
+    if (m_chunk.size() >= kChunkSize) {
+      destination.add(m_chunk.getBuffer().data(), m_chunk.size());
+      written += m_chunk.size();
+      m_chunk.clear();
+    }
+  }
+  if (m_shape == Shape::wide) {
+    writer.endObject();
+  } else {
+    writer.endArray();
+  }
+  destination.add(m_chunk.getBuffer().data(), m_chunk.size());
+  written += m_chunk.size();
+  m_chunk.clear();
+  destination.flush();
+  return (written);
+}
+std::uint64_t JSON_Generator::generate(std::uint64_t size,
+                                       IDestination &&destination) {
+  return (generate(size, destination));
+}
+/// <summary>
+/// Generate a document of at least size bytes and return it.
+/// </summary>
+/// <param name="size">Document size in bytes.</param>
+/// <returns>Generated document.</returns>
+std::string JSON_Generator::generate(std::uint64_t size) {
+  BufferDestination destination{static_cast<std::size_t>(size + kChunkSize)};
+  generate(size, destination);
+  return (std::move(destination).getBuffer());
+}
+/// <summary>
+/// Return shape for a shape name.
+/// </summary>
+/// <param name="name">Shape name.</param>
+JSON_Generator::Shape JSON_Generator::shape(const std::string_view &name) {
+  for (std::size_t shape = 0; shape < kShapeNames.size(); shape++) {
+    if (kShapeNames[shape] == name) {
+      return (static_cast<Shape>(shape));
+    }
+  }
+  throw Error("Unknown shape '" + std::string{name} + "'.");
+}
+/// <summary>
+/// Return name of a shape.
+/// </summary>
+/// <param name="shape">Shape.</param>
+std::string_view JSON_Generator::name(Shape shape) {
+  return (kShapeNames[static_cast<std::size_t>(shape)]);
+}
+/// <summary>
+/// Return list of all shapes.
+/// </summary>
+const std::vector<JSON_Generator::Shape> &JSON_Generator::shapes() {
+  static const std::vector<Shape> shapes{Shape::records, Shape::numeric,
+                                         Shape::nested, Shape::escapes,
+                                         Shape::wide};
+  return (shapes);
+}
+} // namespace JSONLib
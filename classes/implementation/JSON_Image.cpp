@@ -0,0 +1,513 @@
+//
+// Class: JSON_Image
+//
+// Description: Immutable, position independent JSON document image. An
+// image is written once from a JNode tree and can then be memory mapped
+// (and so shared between processes) and queried in place through read
+// only views without any parsing or deserialization. Nodes refer to each
+// other with offsets from the start of the image rather than pointers and
+// objects carry a key table sorted for binary search.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_Image.hpp"
+// =======
+// C++ STL
+// =======
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+// ======
+// POSIX
+// ======
+#if !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+using Tag = JSON_Image::Tag;
+// ===========================================================
+// Image writer; nodes are written depth first (children before
+// their parent) so the image is streamed to the destination in
+// a single pass keeping track of the current offset.
+// ===========================================================
+class ImageWriter {
+public:
+  explicit ImageWriter(IDestination &destination)
+      : m_destination(destination) {}
+  void addWord(std::uint64_t word) {
+    addBytes(reinterpret_cast<const char *>(&word), sizeof(word));
+  }
+  void addBytes(const char *bytes, std::size_t length) {
+    m_destination.add(bytes, length);
+    m_offset += length;
+  }
+  std::uint64_t addString(const std::string_view &string) {
+    static constexpr std::array<char, JSON_Image::kWordSize> padding{};
+    const std::uint64_t offset = m_offset;
+    addWord(string.size());
+    addBytes(string.data(), string.size());
+    addBytes(padding.data(), (JSON_Image::kWordSize -
+                              (string.size() % JSON_Image::kWordSize)) %
+                                 JSON_Image::kWordSize);
+    return (offset);
+  }
+  std::uint64_t addKey(const std::string_view &key) {
+    // Keys repeat (e.g. arrays of records) so each is only written once
+    auto entry = m_keys.find(key);
+    if (entry == m_keys.end()) {
+      entry = m_keys.emplace(key, addString(key)).first;
+    }
+    return (entry->second);
+  }
+  std::uint64_t reference(Tag tag, std::uint64_t offset) {
+    return ((static_cast<std::uint64_t>(tag) << JSON_Image::kTagShift) |
+            offset);
+  }
+  std::uint64_t addJNodes(const JNode &jNode);
+  std::uint64_t addNumber(const JNodeNumeric &number);
+
+private:
+  IDestination &m_destination;
+  std::uint64_t m_offset{};
+  std::unordered_map<std::string_view, std::uint64_t> m_keys;
+};
+/// <summary>
+/// Recursively write a JNode tree returning the reference to its root.
+/// </summary>
+/// <param name="jNode">JNode to write.</param>
+/// <returns>Reference to written node.</returns>
+std::uint64_t ImageWriter::addJNodes(const JNode &jNode) {
+  switch (jNode.getNodeType()) {
+  case JNodeType::object: {
+    const auto &objects = JNodeRef<JNodeObject>(jNode).objects();
+    std::vector<std::uint64_t> entries;
+    entries.reserve(objects.size() * 2);
+    for (auto &[key, jNodePtr] : objects) {
+      entries.push_back(addKey(key));
+      entries.push_back(addJNodes(*jNodePtr));
+    }
+    std::vector<std::uint64_t> sorted(objects.size());
+    for (std::size_t index = 0; index < sorted.size(); index++) {
+      sorted[index] = index;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [&objects](std::uint64_t lhs, std::uint64_t rhs) {
+                       return (std::string_view{objects[lhs].key} <
+                               std::string_view{objects[rhs].key});
+                     });
+    const std::uint64_t offset = m_offset;
+    addWord(objects.size());
+    for (auto word : entries) {
+      addWord(word);
+    }
+    for (auto index : sorted) {
+      addWord(index);
+    }
+    return (reference(Tag::object, offset));
+  }
+  case JNodeType::array: {
+    const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+    std::vector<std::uint64_t> entries;
+    entries.reserve(jNodeArray.size());
+    if (jNodeArray.packing() != JNodeArray::Packing::none) {
+      for (std::size_t index = 0; index < jNodeArray.size(); index++) {
+        entries.push_back(addNumber(jNodeArray.numeric(index)));
+      }
+    } else {
+      for (auto &jNodePtr : jNodeArray.array()) {
+        entries.push_back(addJNodes(*jNodePtr));
+      }
+    }
+    const std::uint64_t offset = m_offset;
+    addWord(entries.size());
+    for (auto word : entries) {
+      addWord(word);
+    }
+    return (reference(Tag::array, offset));
+  }
+  case JNodeType::string:
+    return (reference(Tag::string,
+                      addString(JNodeRef<JNodeString>(jNode).string())));
+  case JNodeType::number:
+    return (addNumber(JNodeRef<JNodeNumber>(jNode).number()));
+  case JNodeType::boolean:
+    return (reference(JNodeRef<JNodeBoolean>(jNode).boolean()
+                          ? Tag::booleanTrue
+                          : Tag::booleanFalse,
+                      0));
+  default:
+    return (reference(Tag::null, 0));
+  }
+}
+/// <summary>
+/// Write a number returning its reference. A float is written as the
+/// double nearest its shortest decimal text (the text it stringifies to)
+/// rather than widened, so 0.1 is held as 0.1 and not 0.10000000149011612.
+/// </summary>
+/// <param name="number">Number to write.</param>
+/// <returns>Reference to written number.</returns>
+std::uint64_t ImageWriter::addNumber(const JNodeNumeric &number) {
+  const std::uint64_t offset = m_offset;
+  if (number.isInt() || number.isLong() || number.isLLong()) {
+    addWord(static_cast<std::uint64_t>(number.getLLong()));
+    return (reference(Tag::integer, offset));
+  }
+  double value = number.getDouble();
+  if (number.isFloat()) {
+    std::array<char, JNodeNumeric::kMaxCharacters> text;
+    const char *end =
+        std::to_chars(text.data(), text.data() + text.size(), number.getFloat())
+            .ptr;
+    std::from_chars(text.data(), end, value);
+  }
+  std::uint64_t word;
+  std::memcpy(&word, &value, sizeof(word));
+  addWord(word);
+  return (reference(Tag::floatingPoint, offset));
+}
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Check image header/trailer so that a truncated, foreign or different
+/// byte order image is rejected up front.
+/// </summary>
+void JSON_Image::checkImage() const {
+  if (m_image.size() < kHeaderSize + kWordSize ||
+      m_image.size() % kWordSize != 0 ||
+      m_image.substr(0, kMagic.size()) != kMagic) {
+    throw Error("Invalid image.");
+  }
+  if (word(kMagic.size()) != kByteOrderMark) {
+    throw Error("Image byte order does not match host.");
+  }
+}
+/// <summary>
+/// Return block offset of object entry for the passed in key (binary
+/// search of the sorted key table); zero if not found.
+/// </summary>
+/// <param name="key">Object entry key.</param>
+/// <returns>Offset of entry (key offset, value reference) or zero.</returns>
+std::uint64_t JSON_Image::View::find(const std::string_view &key) const {
+  if (tag() != Tag::object) {
+    throw JNode::Error("Node not an object.");
+  }
+  const std::uint64_t count = size();
+  const std::uint64_t entries = offset() + kWordSize;
+  const std::uint64_t sorted = entries + count * 2 * kWordSize;
+  std::uint64_t low{0};
+  std::uint64_t high{count};
+  while (low < high) {
+    const std::uint64_t middle = low + (high - low) / 2;
+    const std::uint64_t entry =
+        entries + m_image->word(sorted + middle * kWordSize) * 2 * kWordSize;
+    const auto entryKey = m_image->string(m_image->word(entry));
+    if (entryKey < key) {
+      low = middle + 1;
+    } else if (key < entryKey) {
+      high = middle;
+    } else {
+      return (entry);
+    }
+  }
+  return (0);
+}
+/// <summary>
+/// Open an image held in memory owned by the caller.
+/// </summary>
+/// <param name="image">Image bytes.</param>
+JSON_Image::JSON_Image(const std::string_view &image) : m_image(image) {
+  checkImage();
+}
+/// <summary>
+/// Open an image file; the file is mapped read only so its pages are
+/// shared by all processes that have it open.
+/// </summary>
+/// <param name="fileName">Image file name.</param>
+JSON_Image::JSON_Image(const std::string &fileName) {
+#if defined(_WIN64)
+  std::ifstream file{fileName, std::ios_base::binary};
+  if (!file.is_open()) {
+    throw Error("Image file failed to open or does not exist.");
+  }
+  m_buffer.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+  m_image = m_buffer;
+#else
+  const int file = ::open(fileName.c_str(), O_RDONLY);
+  if (file == -1) {
+    throw Error("Image file failed to open or does not exist.");
+  }
+  struct stat status {};
+  if (::fstat(file, &status) == -1 || status.st_size == 0) {
+    ::close(file);
+    throw Error("Invalid image.");
+  }
+  const auto length = static_cast<std::size_t>(status.st_size);
+  void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, file, 0);
+  ::close(file);
+  if (mapping == MAP_FAILED) {
+    throw Error("Image file could not be mapped.");
+  }
+  m_mapping = mapping;
+  m_image = std::string_view{static_cast<const char *>(mapping), length};
+#endif
+  try {
+    checkImage();
+  } catch (...) {
+#if !defined(_WIN64)
+    ::munmap(m_mapping, m_image.size());
+#endif
+    throw;
+  }
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// Unmap any mapped image file.
+/// </summary>
+JSON_Image::~JSON_Image() {
+#if !defined(_WIN64)
+  if (m_mapping != nullptr) {
+    ::munmap(m_mapping, m_image.size());
+  }
+#endif
+}
+/// <summary>
+/// Open an image file; the file is mapped read only so its pages are
+/// shared by all processes that have it open.
+/// </summary>
+/// <param name="fileName">Image file name.</param>
+/// <returns>Image.</returns>
+JSON_Image JSON_Image::open(const std::string &fileName) {
+  return (JSON_Image{fileName});
+}
+/// <summary>
+/// Open an image held in memory owned by the caller (which must outlive
+/// the image).
+/// </summary>
+/// <param name="image">Image bytes.</param>
+/// <returns>Image.</returns>
+JSON_Image JSON_Image::fromMemory(const std::string_view &image) {
+  return (JSON_Image{image});
+}
+/// <summary>
+/// Write the image of a JNode tree to a destination.
+/// </summary>
+/// <param name="jNode">Root of JNode tree.</param>
+/// <param name="destination">Destination for image.</param>
+void JSON_Image::write(const JNode &jNode, IDestination &destination) {
+  ImageWriter writer{destination};
+  writer.addBytes(kMagic.data(), kMagic.size());
+  writer.addWord(kByteOrderMark);
+  writer.addWord(writer.addJNodes(jNode));
+  destination.flush();
+}
+void JSON_Image::write(const JNode &jNode, IDestination &&destination) {
+  write(jNode, destination);
+}
+/// <summary>
+/// Return view of the root node.
+/// </summary>
+JSON_Image::View JSON_Image::root() const {
+  return (View{this, word(m_image.size() - kWordSize)});
+}
+/// <summary>
+/// Return 64 bit word at image offset.
+/// </summary>
+/// <param name="offset">Image offset.</param>
+std::uint64_t JSON_Image::word(std::uint64_t offset) const {
+  if (offset > m_image.size() - kWordSize) {
+    throw Error("Invalid offset.");
+  }
+  std::uint64_t word;
+  std::memcpy(&word, m_image.data() + offset, sizeof(word));
+  return (word);
+}
+/// <summary>
+/// Return string whose block is at image offset.
+/// </summary>
+/// <param name="offset">Image offset of string block.</param>
+std::string_view JSON_Image::string(std::uint64_t offset) const {
+  const std::uint64_t length = word(offset);
+  if (length > m_image.size() - offset - kWordSize) {
+    throw Error("Invalid offset.");
+  }
+  return (m_image.substr(offset + kWordSize, length));
+}
+/// <summary>
+/// Return node type.
+/// </summary>
+JNodeType JSON_Image::View::getNodeType() const {
+  switch (tag()) {
+  case Tag::object:
+    return (JNodeType::object);
+  case Tag::array:
+    return (JNodeType::array);
+  case Tag::string:
+    return (JNodeType::string);
+  case Tag::integer:
+  case Tag::floatingPoint:
+    return (JNodeType::number);
+  case Tag::booleanTrue:
+  case Tag::booleanFalse:
+    return (JNodeType::boolean);
+  case Tag::null:
+    return (JNodeType::null);
+  default:
+    throw Error("Invalid node reference.");
+  }
+}
+/// <summary>
+/// Return number of entries in an object/array.
+/// </summary>
+std::size_t JSON_Image::View::size() const {
+  if (tag() != Tag::object && tag() != Tag::array) {
+    throw JNode::Error("Node not an object or array.");
+  }
+  return (m_image->word(offset()));
+}
+/// <summary>
+/// Return view of object entry for the passed in key.
+/// </summary>
+/// <param name="key">Object entry key.</param>
+JSON_Image::View
+JSON_Image::View::operator[](const std::string_view &key) const {
+  const std::uint64_t entry = find(key);
+  if (entry == 0) {
+    throw JNode::Error("Invalid key used to access object.");
+  }
+  return (View{m_image, m_image->word(entry + kWordSize)});
+}
+/// <summary>
+/// Return view of array entry for the passed in index.
+/// </summary>
+/// <param name="index">Array entry index.</param>
+JSON_Image::View JSON_Image::View::operator[](std::size_t index) const {
+  if (tag() != Tag::array) {
+    throw JNode::Error("Node not an array.");
+  }
+  if (index >= size()) {
+    throw JNode::Error("Invalid index used to access array.");
+  }
+  return (View{m_image, m_image->word(offset() + (index + 1) * kWordSize)});
+}
+/// <summary>
+/// Return true if an object contains a given key.
+/// </summary>
+/// <param name="key">Object entry key.</param>
+bool JSON_Image::View::contains(const std::string_view &key) const {
+  return (find(key) != 0);
+}
+/// <summary>
+/// Return string value.
+/// </summary>
+std::string_view JSON_Image::View::string() const {
+  if (tag() != Tag::string) {
+    throw JNode::Error("Node not a string.");
+  }
+  return (m_image->string(offset()));
+}
+/// <summary>
+/// Return numeric value as a long long.
+/// </summary>
+long long JSON_Image::View::getLLong() const {
+  if (tag() == Tag::integer) {
+    return (static_cast<long long>(m_image->word(offset())));
+  }
+  return (static_cast<long long>(getDouble()));
+}
+/// <summary>
+/// Return numeric value as a double.
+/// </summary>
+double JSON_Image::View::getDouble() const {
+  if (tag() == Tag::integer) {
+    return (static_cast<double>(getLLong()));
+  }
+  if (tag() != Tag::floatingPoint) {
+    throw JNode::Error("Node not a number.");
+  }
+  const std::uint64_t word = m_image->word(offset());
+  double value;
+  std::memcpy(&value, &word, sizeof(value));
+  return (value);
+}
+/// <summary>
+/// Return boolean value.
+/// </summary>
+bool JSON_Image::View::boolean() const {
+  if (tag() != Tag::booleanTrue && tag() != Tag::booleanFalse) {
+    throw JNode::Error("Node not an boolean.");
+  }
+  return (tag() == Tag::booleanTrue);
+}
+/// <summary>
+/// Return iterator to first child of object/array.
+/// </summary>
+JSON_Image::View::Iterator JSON_Image::View::begin() const {
+  if (tag() != Tag::object && tag() != Tag::array) {
+    throw JNode::Error("Node not an object or array.");
+  }
+  return (Iterator{m_image, offset() + kWordSize, tag() == Tag::object});
+}
+/// <summary>
+/// Return iterator past last child of object/array.
+/// </summary>
+JSON_Image::View::Iterator JSON_Image::View::end() const {
+  const std::uint64_t entrySize = (tag() == Tag::object ? 2 : 1) * kWordSize;
+  return (Iterator{m_image, offset() + kWordSize + size() * entrySize,
+                   tag() == Tag::object});
+}
+/// <summary>
+/// Return view of current child.
+/// </summary>
+JSON_Image::View JSON_Image::View::Iterator::operator*() const {
+  return (View{m_image,
+               m_image->word(m_object ? m_entry + kWordSize : m_entry)});
+}
+/// <summary>
+/// Return key for current object entry.
+/// </summary>
+std::string_view JSON_Image::View::Iterator::key() const {
+  if (!m_object) {
+    throw JNode::Error("Node not an object.");
+  }
+  return (m_image->string(m_image->word(m_entry)));
+}
+/// <summary>
+/// Move to next child.
+/// </summary>
+JSON_Image::View::Iterator &JSON_Image::View::Iterator::operator++() {
+  m_entry += (m_object ? 2 : 1) * kWordSize;
+  return (*this);
+}
+} // namespace JSONLib
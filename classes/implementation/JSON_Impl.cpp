@@ -12,6 +12,12 @@
 // =================
 #include "JSON_Impl.hpp"
 #include "JSON.hpp"
+#include "JSON_Binary.hpp"
+#include "JSON_Destinations.hpp"
+#include "JSON_JNodeReclaimer.hpp"
+#include "JSON_Minifier.hpp"
+#include "JSON_NumberScanner.hpp"
+#include "JSON_WorkStealingPool.hpp"
 
 // ====================
 // CLASS IMPLEMENTATION
@@ -36,19 +42,28 @@ namespace JSONLib {
 // PRIVATE METHODS
 // ===============
 /// <summary>
+/// Return true if a character can start a number.
+/// </summary>
+/// <param name="ch">Character.</param>
+static bool isNumberStart(char ch) {
+  return ((ch >= '0' && ch <= '9') || ch == '-' || ch == '+');
+}
+/// <summary>
 /// Extract a string from a JSON encoded source stream.
 /// </summary>
 /// <param name="source">Source of JSON.</param>
 /// <param name="translate">== true and escapes found then they need
 /// translating.</param>
-/// <returns>Extracted string</returns>
-std::string JSON_Impl::extractString(ISource &source, bool translate) {
+/// <returns>Extracted string (valid until the next extraction).</returns>
+std::string_view JSON_Impl::extractString(ISource &source, bool translate) {
   bool translateEscapes = false;
   if (source.current() != '"') {
     throw Error("Syntax error detected.");
   }
   source.next();
-  std::string stringValue;
+  // Reuse scratch buffer so that its capacity is kept between strings
+  std::string &stringValue = m_stringScratch;
+  stringValue.clear();
   while (source.more() && source.current() != '"') {
     if (source.current() == '\\') {
       stringValue += '\\';
@@ -67,12 +82,12 @@ std::string JSON_Impl::extractString(ISource &source, bool translate) {
   source.next();
   // Need to translate escapes to UTF8
   if (translateEscapes) {
-    return (m_translator->fromJSON(stringValue));
-  }
-  // None so just pass on
-  else {
-    return (stringValue);
+    if constexpr (kStatistics) {
+      m_statistics.escapedStrings++;
+    }
+    stringValue = m_translator->fromJSON(stringValue);
   }
+  return (stringValue);
 }
 /// <summary>
 /// Parse a key/value pair from a JSON encoded source stream.
@@ -81,13 +96,13 @@ std::string JSON_Impl::extractString(ISource &source, bool translate) {
 /// <returns>Object key/value pair.</returns>
 JNodeObject::ObjectEntry JSON_Impl::parseKeyValuePair(ISource &source) {
   source.ignoreWS();
-  const std::string keyValue{extractString(source)};
+  std::pmr::string keyValue{extractString(source), m_resource};
   source.ignoreWS();
   if (source.current() != ':') {
     throw Error("Syntax error detected.");
   }
   source.next();
-  return (JNodeObject::ObjectEntry{keyValue, parseJNodes(source)});
+  return (JNodeObject::ObjectEntry{std::move(keyValue), parseJNodes(source)});
 }
 /// <summary>
 /// Parse a string from a JSON source stream.
@@ -95,24 +110,175 @@ JNodeObject::ObjectEntry JSON_Impl::parseKeyValuePair(ISource &source) {
 /// <param name="source">Source of JSON.</param>
 /// <returns>String JNode.</returns>
 JNode::Ptr JSON_Impl::parseString(ISource &source) {
-  return (makeString(extractString(source)));
+  if constexpr (kStatistics) {
+    m_statistics.strings++;
+  }
+  return (makeString(extractString(source), m_resource));
 }
 /// <summary>
-/// Parse a number from a JSON source stream.
+/// Extract a number from a JSON source stream. Integers held in memory are
+/// converted in place; the text of any other number is left in the string
+/// scratch buffer until the next extraction.
 /// </summary>
 /// <param name="source">Source of JSON.</param>
-/// <returns>Number JNode.</returns>
-JNode::Ptr JSON_Impl::parseNumber(ISource &source) {
-  std::string number;
+/// <returns>Extracted number.</returns>
+JNodeNumeric JSON_Impl::extractNumber(ISource &source) {
+  if (const auto text = source.buffered(); !text.empty()) {
+    JSON_NumberScanner::Number scanned;
+    if (const auto length = JSON_NumberScanner::scan(text, scanned);
+        length != 0 && scanned.kind == JSON_NumberScanner::Kind::integer) {
+      source.skip(length);
+      if constexpr (kStatistics) {
+        m_statistics.numbers++;
+        if (!std::in_range<int>(scanned.integer)) {
+          m_statistics.numericFallbacks++;
+        }
+      }
+      if (std::in_range<int>(scanned.integer)) {
+        return (JNodeNumeric{static_cast<int>(scanned.integer)});
+      }
+      if (std::in_range<long>(scanned.integer)) {
+        return (JNodeNumeric{static_cast<long>(scanned.integer)});
+      }
+      return (JNodeNumeric{static_cast<long long>(scanned.integer)});
+    }
+  }
+  std::string &number = m_stringScratch;
+  number.clear();
   for (; source.more() && JNodeNumeric::isValidNumericChar(source.current());
        source.next()) {
     number += source.current();
   }
-  JNodeNumeric jNodeNumeric{number};
+  JNodeNumeric jNodeNumeric;
   if (!jNodeNumeric.setValidNumber(number)) {
     throw Error("Syntax error detected.");
   }
-  return (makeNumber(jNodeNumeric));
+  if constexpr (kStatistics) {
+    m_statistics.numbers++;
+    if (!jNodeNumeric.isInt()) {
+      m_statistics.numericFallbacks++;
+    }
+  }
+  return (jNodeNumeric);
+}
+/// <summary>
+/// Parse a number from a JSON source stream.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+/// <returns>Number JNode.</returns>
+JNode::Ptr JSON_Impl::parseNumber(ISource &source) {
+  return (makeNumber(extractNumber(source), m_resource));
+}
+/// <summary>
+/// Parse the run of numbers at the start of an array. If the array holds
+/// only integers (that fit 64 bits), only floats or only (finite) doubles
+/// it is returned packed, each value keeping the type it would be given
+/// as a JNode; otherwise a JNode for each number read is added to the
+/// array entry list and parsing carries on from where the run stopped.
+/// Runs held in memory are first tried with the number scanner, which
+/// reads the whole array in one pass; if it cannot take the run (or cannot
+/// be sure of the type of its values) nothing is consumed and the numbers
+/// are read one by one.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+/// <param name="array">Array entry list.</param>
+/// <param name="expectElement">Set to true if the run stopped on an
+/// element following a comma.</param>
+/// <returns>Packed array JNode or nullptr if not packed.</returns>
+JNode::Ptr JSON_Impl::parseNumericArray(ISource &source,
+                                        JNodeArray::ArrayList &array,
+                                        bool &expectElement) {
+  expectElement = false;
+  if (const auto text = source.buffered(); !text.empty()) {
+    const auto run = JSON_NumberScanner::scanRun(text, m_integerScratch,
+                                                 m_floatingPointScratch);
+    if (run.kind == JSON_NumberScanner::Kind::integer) {
+      source.skip(run.length);
+      if constexpr (kStatistics) {
+        m_statistics.numbers += m_integerScratch.size();
+        m_statistics.numericFallbacks += static_cast<std::size_t>(
+            std::ranges::count_if(m_integerScratch, [](std::int64_t value) {
+              return (!std::in_range<int>(value));
+            }));
+      }
+      return (makeJNode(
+          JNodeArray{std::span<const std::int64_t>{m_integerScratch},
+                     m_resource},
+          m_resource));
+    }
+    if (run.kind == JSON_NumberScanner::Kind::floatingPoint) {
+      const bool floats =
+          JSON_NumberScanner::toFloats(m_floatingPointScratch, m_floatScratch);
+      if (floats || JSON_NumberScanner::beyondFloat(m_floatingPointScratch)) {
+        source.skip(run.length);
+        if constexpr (kStatistics) {
+          m_statistics.numbers += m_floatingPointScratch.size();
+          m_statistics.numericFallbacks += m_floatingPointScratch.size();
+        }
+        if (floats) {
+          return (makeJNode(
+              JNodeArray{std::span<const float>{m_floatScratch}, m_resource},
+              m_resource));
+        }
+        return (makeJNode(JNodeArray{std::span<const double>{
+                                         m_floatingPointScratch},
+                                     m_resource},
+                          m_resource));
+      }
+    }
+  }
+  m_numericScratch.clear();
+  m_integerScratch.clear();
+  m_floatingPointScratch.clear();
+  m_floatScratch.clear();
+  bool packable{true};
+  while (true) {
+    const JNodeNumeric numeric{extractNumber(source)};
+    m_numericScratch.push_back(numeric);
+    if (numeric.isInt() || numeric.isLong() || numeric.isLLong()) {
+      m_integerScratch.push_back(numeric.getLLong());
+    } else if (numeric.isFloat()) {
+      m_floatScratch.push_back(numeric.getFloat());
+    } else if (numeric.isDouble() && std::isfinite(numeric.getDouble())) {
+      m_floatingPointScratch.push_back(numeric.getDouble());
+    } else {
+      packable = false;
+    }
+    source.ignoreWS();
+    if (source.current() != ',') {
+      break;
+    }
+    source.next();
+    source.ignoreWS();
+    if (!isNumberStart(source.current())) {
+      expectElement = true;
+      break;
+    }
+  }
+  if (packable && source.current() == ']') {
+    const std::size_t count = m_numericScratch.size();
+    if (m_integerScratch.size() == count) {
+      return (makeJNode(
+          JNodeArray{std::span<const std::int64_t>{m_integerScratch},
+                     m_resource},
+          m_resource));
+    }
+    if (m_floatScratch.size() == count) {
+      return (makeJNode(
+          JNodeArray{std::span<const float>{m_floatScratch}, m_resource},
+          m_resource));
+    }
+    if (m_floatingPointScratch.size() == count) {
+      return (makeJNode(JNodeArray{std::span<const double>{
+                                       m_floatingPointScratch},
+                                   m_resource},
+                        m_resource));
+    }
+  }
+  for (auto &numeric : m_numericScratch) {
+    array.emplace_back(makeNumber(numeric, m_resource));
+  }
+  return (nullptr);
 }
 /// <summary>
 /// Parse a boolean from a JSON source stream.
@@ -120,11 +286,14 @@ JNode::Ptr JSON_Impl::parseNumber(ISource &source) {
 /// <param name="source">Source of JSON.</param>
 /// <returns>Boolean JNode.</returns>
 JNode::Ptr JSON_Impl::parseBoolean(ISource &source) {
+  if constexpr (kStatistics) {
+    m_statistics.booleans++;
+  }
   if (source.match("true")) {
-    return (makeBoolean(true));
+    return (makeBoolean(true, m_resource));
   }
   if (source.match("false")) {
-    return (makeBoolean(false));
+    return (makeBoolean(false, m_resource));
   }
   throw Error("Syntax error detected.");
 }
@@ -137,7 +306,10 @@ JNode::Ptr JSON_Impl::parseNull(ISource &source) {
   if (!source.match("null")) {
     throw Error("Syntax error detected.");
   }
-  return (makeNull());
+  if constexpr (kStatistics) {
+    m_statistics.nulls++;
+  }
+  return (makeNull(m_resource));
 }
 /// <summary>
 /// Parse an object from a JSON source stream.
@@ -145,7 +317,11 @@ JNode::Ptr JSON_Impl::parseNull(ISource &source) {
 /// <param name="source">Source of JSON.</param>
 /// <returns>Object JNode (key/value pairs).</returns>
 JNode::Ptr JSON_Impl::parseObject(ISource &source) {
-  JNodeObject::ObjectList objects;
+  JNodeObject::ObjectList objects{m_resource};
+  if constexpr (kStatistics) {
+    m_statistics.objects++;
+    m_statistics.maxDepth = std::max(m_statistics.maxDepth, ++m_depth);
+  }
   source.next();
   source.ignoreWS();
   if (source.current() != '}') {
@@ -159,7 +335,10 @@ JNode::Ptr JSON_Impl::parseObject(ISource &source) {
     throw Error("Syntax error detected.");
   }
   source.next();
-  return (makeObject(objects));
+  if constexpr (kStatistics) {
+    m_depth--;
+  }
+  return (makeObject(objects, m_resource));
 }
 /// <summary>
 /// Parse an array from a JSON source stream.
@@ -167,11 +346,22 @@ JNode::Ptr JSON_Impl::parseObject(ISource &source) {
 /// <param name="source">Source of JSON.</param>
 /// <returns>Array JNode.</returns>
 JNode::Ptr JSON_Impl::parseArray(ISource &source) {
-  JNodeArray::ArrayList array;
+  JNodeArray::ArrayList array{m_resource};
+  JNode::Ptr packed;
+  if constexpr (kStatistics) {
+    m_statistics.arrays++;
+    m_statistics.maxDepth = std::max(m_statistics.maxDepth, ++m_depth);
+  }
   source.next();
   source.ignoreWS();
   if (source.current() != ']') {
-    array.emplace_back(parseJNodes(source));
+    bool expectElement{true};
+    if (isNumberStart(source.current())) {
+      packed = parseNumericArray(source, array, expectElement);
+    }
+    if (expectElement) {
+      array.emplace_back(parseJNodes(source));
+    }
     while (source.current() == ',') {
       source.next();
       array.emplace_back(parseJNodes(source));
@@ -181,7 +371,13 @@ JNode::Ptr JSON_Impl::parseArray(ISource &source) {
     throw Error("Syntax error detected.");
   }
   source.next();
-  return (makeArray(array));
+  if constexpr (kStatistics) {
+    m_depth--;
+  }
+  if (packed != nullptr) {
+    return (packed);
+  }
+  return (makeArray(array, m_resource));
 }
 /// <summary>
 /// Recursively parse JSON source stream producing a JNode structure
@@ -230,6 +426,365 @@ JNode::Ptr JSON_Impl::parseJNodes(ISource &source) {
   return (jNode);
 }
 /// <summary>
+/// Validate a string on a JSON source stream. This applies the same escape
+/// and unpaired surrogate checks as the default translator but nothing is
+/// decoded or stored.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Impl::validateString(ISource &source) {
+  auto hexDigit = [](char ch) -> int {
+    if (ch >= '0' && ch <= '9') {
+      return (ch - '0');
+    }
+    if (ch >= 'a' && ch <= 'f') {
+      return (ch - 'a' + 10);
+    }
+    if (ch >= 'A' && ch <= 'F') {
+      return (ch - 'A' + 10);
+    }
+    throw Error("Syntax error detected.");
+  };
+  source.next();
+  // ==true then last character was a high surrogate escape
+  bool highSurrogate{false};
+  while (source.more() && source.current() != '"') {
+    char16_t utf16Char{};
+    if (source.current() == '\\') {
+      source.next();
+      if (!source.more()) {
+        throw Error("Syntax error detected.");
+      }
+      if (source.current() == 'u') {
+        for (int digit = 0; digit < 4; digit++) {
+          source.next();
+          utf16Char = static_cast<char16_t>((utf16Char << 4) |
+                                            hexDigit(source.current()));
+        }
+      }
+    }
+    const bool high =
+        utf16Char >= kHighSurrogatesBegin && utf16Char <= kHighSurrogatesEnd;
+    const bool low =
+        utf16Char >= kLowSurrogatesBegin && utf16Char <= kLowSurrogatesEnd;
+    if ((highSurrogate && !low) || (!highSurrogate && low)) {
+      throw Error("Syntax error detected.");
+    }
+    highSurrogate = high;
+    source.next();
+  }
+  if (highSurrogate || source.current() != '"') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+}
+/// <summary>
+/// Validate a number on a JSON source stream. A number is valid if it can
+/// be converted to any of the supported numeric types; the widest of these
+/// (long double) accepts all that the others do.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Impl::validateNumber(ISource &source) {
+  if (const auto text = source.buffered(); !text.empty()) {
+    JSON_NumberScanner::Number scanned;
+    if (const auto length = JSON_NumberScanner::scan(text, scanned);
+        length != 0) {
+      source.skip(length);
+      return;
+    }
+  }
+  // Validate may run on a shared const JSON from several threads at once
+  // so the member scratch buffer cannot be used here
+  std::string number;
+  for (; source.more() && JNodeNumeric::isValidNumericChar(source.current());
+       source.next()) {
+    number += source.current();
+  }
+  char *end;
+  std::strtold(number.c_str(), &end);
+  if (number.empty() || *end != '\0') {
+    throw Error("Syntax error detected.");
+  }
+}
+/// <summary>
+/// Validate an object on a JSON source stream.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Impl::validateObject(ISource &source) {
+  auto validateKeyValuePair = [this, &source]() {
+    source.ignoreWS();
+    if (source.current() != '"') {
+      throw Error("Syntax error detected.");
+    }
+    validateString(source);
+    source.ignoreWS();
+    if (source.current() != ':') {
+      throw Error("Syntax error detected.");
+    }
+    source.next();
+    validateJNodes(source);
+  };
+  source.next();
+  source.ignoreWS();
+  if (source.current() != '}') {
+    validateKeyValuePair();
+    while (source.current() == ',') {
+      source.next();
+      validateKeyValuePair();
+    }
+  }
+  if (source.current() != '}') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+}
+/// <summary>
+/// Validate an array on a JSON source stream.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Impl::validateArray(ISource &source) {
+  source.next();
+  source.ignoreWS();
+  if (source.current() != ']') {
+    validateJNodes(source);
+    while (source.current() == ',') {
+      source.next();
+      validateJNodes(source);
+    }
+  }
+  if (source.current() != ']') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+}
+/// <summary>
+/// Recursively validate JSON on a source stream; this follows the same
+/// grammar as parseJNodes() but builds nothing.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Impl::validateJNodes(ISource &source) {
+  source.ignoreWS();
+  switch (source.current()) {
+  case '{':
+    validateObject(source);
+    break;
+  case '[':
+    validateArray(source);
+    break;
+  case '"':
+    validateString(source);
+    break;
+  case 't':
+  case 'f':
+    if (!source.match("true") && !source.match("false")) {
+      throw Error("Syntax error detected.");
+    }
+    break;
+  case 'n':
+    if (!source.match("null")) {
+      throw Error("Syntax error detected.");
+    }
+    break;
+  case '-':
+  case '+':
+  case '0':
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    validateNumber(source);
+    break;
+  default:
+    throw Error("Syntax error detected.");
+  }
+  source.ignoreWS();
+}
+/// <summary>
+/// Return the number of bytes a string will take once stringified with
+/// the default translator (including its enclosing quotes).
+/// </summary>
+/// <param name=string>UTF-8 string.</param>
+/// <returns>Stringified size in bytes.</returns>
+static std::size_t estimateString(const std::string_view &string) {
+  return (JSON_Translator::escapedSize(string) + 2);
+}
+/// <summary>
+/// Estimate the stringified size of packed array values.
+/// </summary>
+/// <param name=values>Packed values.</param>
+/// <returns>Estimated stringified size in bytes.</returns>
+template <typename T>
+static std::size_t estimatePacked(std::span<const T> values) {
+  std::size_t size{2 + values.size()};
+  for (const auto value : values) {
+    size += JNodeNumeric::maxCharacters(value);
+  }
+  return (size);
+}
+/// <summary>
+/// Recursively traverse JNode structure estimating the size of its
+/// stringified JSON so that the destination can reserve space up front.
+/// Numbers use an upper bound so the estimate should not be exceeded.
+/// </summary>
+/// <param name=jNode>JNode structure to be traversed.</param>
+/// <returns>Estimated stringified size in bytes.</returns>
+std::size_t JSON_Impl::estimateJNodes(const JNode &jNode) {
+  switch (jNode.getNodeType()) {
+  case JNodeType::number:
+    return (JNodeRef<JNodeNumber>(jNode).number().maxCharacters());
+  case JNodeType::string:
+    return (estimateString(JNodeRef<JNodeString>(jNode).string()));
+  case JNodeType::boolean:
+    return (JNodeRef<JNodeBoolean>(jNode).boolean() ? 4 : 5);
+  case JNodeType::object: {
+    const auto &objects = JNodeRef<JNodeObject>(jNode).objects();
+    std::size_t size{2 + (objects.empty() ? 0 : objects.size() - 1)};
+    for (auto &[key, jNodePtr] : objects) {
+      size += estimateString(key) + 1 + estimateJNodes(*jNodePtr);
+    }
+    return (size);
+  }
+  case JNodeType::array: {
+    const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+    switch (jNodeArray.packing()) {
+    case JNodeArray::Packing::integer:
+      return (estimatePacked(jNodeArray.integers()));
+    case JNodeArray::Packing::floatingPoint:
+      return (estimatePacked(jNodeArray.floatingPoints()));
+    case JNodeArray::Packing::floatingPoint32:
+      return (estimatePacked(jNodeArray.floatingPoints32()));
+    default:
+      break;
+    }
+    const auto &array = jNodeArray.array();
+    std::size_t size{2 + (array.empty() ? 0 : array.size() - 1)};
+    for (auto &jNodePtr : array) {
+      size += estimateJNodes(*jNodePtr);
+    }
+    return (size);
+  }
+  default:
+    return (4); // null/hole
+  }
+}
+/// <summary>
+/// Return an estimate of the bytes a string has allocated from its memory
+/// resource (zero if it is short enough to be held inline).
+/// </summary>
+/// <param name=string>String.</param>
+/// <returns>Allocated size in bytes.</returns>
+static std::size_t allocatedString(const std::pmr::string &string) {
+  static const std::size_t kInlineCapacity{std::pmr::string{}.capacity()};
+  return (string.capacity() > kInlineCapacity ? string.capacity() + 1 : 0);
+}
+/// <summary>
+/// Recursively traverse JNode structure breaking down the bytes it has
+/// allocated by use. The sizes are estimated from the nodes themselves
+/// (container capacity not size); the bytes actually held come from
+/// counting allocations where possible.
+/// </summary>
+/// <param name=jNode>JNode structure to be traversed.</param>
+/// <param name=usage>Memory usage to add to.</param>
+void JSON_Impl::measureJNodes(const JNode &jNode, JSON::MemoryUsage &usage) {
+  usage.nodes++;
+  usage.nodeBytes += sizeof(JNode);
+  switch (jNode.getNodeType()) {
+  case JNodeType::string:
+    usage.stringBytes += allocatedString(JNodeRef<JNodeString>(jNode).string());
+    break;
+  case JNodeType::number:
+    usage.numberBytes += JNodeRef<JNodeNumber>(jNode).number().allocatedBytes();
+    break;
+  case JNodeType::object: {
+    const auto &objects = JNodeRef<JNodeObject>(jNode).objects();
+    usage.containerBytes += objects.capacity() * sizeof(JNodeObject::ObjectEntry);
+    usage.containerUnusedBytes += (objects.capacity() - objects.size()) *
+                                  sizeof(JNodeObject::ObjectEntry);
+    for (auto &[key, jNodePtr] : objects) {
+      usage.keyBytes += allocatedString(key);
+      measureJNodes(*jNodePtr, usage);
+    }
+    break;
+  }
+  case JNodeType::array: {
+    const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+    if (jNodeArray.packing() != JNodeArray::Packing::none) {
+      usage.containerBytes += jNodeArray.packedBytes();
+      break;
+    }
+    const auto &array = jNodeArray.array();
+    usage.containerBytes += array.capacity() * sizeof(JNode::Ptr);
+    usage.containerUnusedBytes +=
+        (array.capacity() - array.size()) * sizeof(JNode::Ptr);
+    for (auto &jNodePtr : array) {
+      measureJNodes(*jNodePtr, usage);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+/// <summary>
+/// Encode an object key (plus its trailing colon) on the destination.
+/// </summary>
+/// <param name=key>Object entry key.</param>
+/// <param name=destination>Destination stream for stringified JSON.</param>
+void JSON_Impl::stringifyKey(const std::pmr::string &key,
+                             IDestination &destination) {
+  stringifyString(key, destination);
+  destination.add(':');
+}
+/// <summary>
+/// Encode a quoted string on the destination. With the default translator
+/// the escaped string is written straight into the destination.
+/// </summary>
+/// <param name=string>String to encode.</param>
+/// <param name=destination>Destination stream for stringified JSON.</param>
+void JSON_Impl::stringifyString(const std::string_view &string,
+                                IDestination &destination) {
+  if (m_escapeDirect) {
+    auto buffer = destination.prepare(estimateString(string));
+    buffer[0] = '"';
+    if (char *end = JSON_Translator::escape(string, &buffer[1]);
+        end != nullptr) {
+      *end++ = '"';
+      destination.commit(end - buffer.data());
+      return;
+    }
+    destination.commit(0);
+  }
+  destination.add('"');
+  destination.add(m_translator->toJSON(std::string{string}));
+  destination.add('"');
+}
+/// <summary>
+/// Encode packed array values on the destination.
+/// </summary>
+/// <param name=values>Packed values.</param>
+/// <param name=destination>Destination stream for stringified JSON.</param>
+template <typename T>
+static void stringifyPacked(std::span<const T> values,
+                            IDestination &destination) {
+  destination.add('[');
+  for (std::size_t index = 0; index < values.size(); index++) {
+    auto buffer =
+        destination.prepare(JNodeNumeric::maxCharacters(values[index]) + 1);
+    char *end = buffer.data();
+    if (index != 0) {
+      *end++ = ',';
+    }
+    end = JNodeNumeric::numericToChars(end, buffer.data() + buffer.size(),
+                                       values[index]);
+    destination.commit(end - buffer.data());
+  }
+  destination.add(']');
+}
+/// <summary>
 /// Recursively traverse JNode structure encoding it into JSON on
 /// the destination stream passed in.
 /// </summary>
@@ -237,14 +792,16 @@ JNode::Ptr JSON_Impl::parseJNodes(ISource &source) {
 /// <param name=destination>Destination stream for stringified JSON.</param>
 void JSON_Impl::stringifyJNodes(const JNode &jNode, IDestination &destination) {
   switch (jNode.getNodeType()) {
-  case JNodeType::number:
-    destination.add(JNodeRef<const JNodeNumber>(jNode).toString());
+  case JNodeType::number: {
+    const auto &numeric = JNodeRef<JNodeNumber>(jNode).number();
+    auto buffer = destination.prepare(numeric.maxCharacters());
+    const char *end =
+        numeric.toChars(buffer.data(), buffer.data() + buffer.size());
+    destination.commit(end - buffer.data());
     break;
+  }
   case JNodeType::string:
-    destination.add('"');
-    destination.add(
-        m_translator->toJSON(JNodeRef<JNodeString>(jNode).toString()));
-    destination.add('"');
+    stringifyString(JNodeRef<JNodeString>(jNode).string(), destination);
     break;
   case JNodeType::boolean:
     destination.add(JNodeRef<JNodeBoolean>(jNode).toString());
@@ -259,10 +816,8 @@ void JSON_Impl::stringifyJNodes(const JNode &jNode, IDestination &destination) {
     int commaCount = JNodeRef<JNodeObject>(jNode).size() - 1;
     destination.add('{');
     for (auto &[key, jNodePtr] : JNodeRef<JNodeObject>(jNode).objects()) {
-      destination.add('"');
-      destination.add(m_translator->toJSON(key));
-      destination.add("\":");
-      stringifyJNodes(JNodeRef<JNodeObject>(jNode)[key], destination);
+      stringifyKey(key, destination);
+      stringifyJNodes(*jNodePtr, destination);
       if (commaCount-- > 0) {
         destination.add(',');
       }
@@ -271,6 +826,23 @@ void JSON_Impl::stringifyJNodes(const JNode &jNode, IDestination &destination) {
     break;
   }
   case JNodeType::array: {
+    if (JNodeRef<JNodeArray>(jNode).packing() ==
+        JNodeArray::Packing::integer) {
+      stringifyPacked(JNodeRef<JNodeArray>(jNode).integers(), destination);
+      break;
+    }
+    if (JNodeRef<JNodeArray>(jNode).packing() ==
+        JNodeArray::Packing::floatingPoint) {
+      stringifyPacked(JNodeRef<JNodeArray>(jNode).floatingPoints(),
+                      destination);
+      break;
+    }
+    if (JNodeRef<JNodeArray>(jNode).packing() ==
+        JNodeArray::Packing::floatingPoint32) {
+      stringifyPacked(JNodeRef<JNodeArray>(jNode).floatingPoints32(),
+                      destination);
+      break;
+    }
     std::size_t commaCount = JNodeRef<JNodeArray>(jNode).size() - 1;
     destination.add('[');
     for (auto &bNodeEntry : JNodeRef<JNodeArray>(jNode).array()) {
@@ -287,27 +859,87 @@ void JSON_Impl::stringifyJNodes(const JNode &jNode, IDestination &destination) {
   }
 }
 /// <summary>
+/// Set whether JNode trees are destroyed on a background reclaimer thread.
+/// Any memory resource used must outlive the reclamation (see deferrable()
+/// for the resources whose trees are deferred).
+/// </summary>
+/// <param name=deferDestruction>==true then defer destruction.</param>
+void JSON_Impl::deferDestruction(bool deferDestruction) {
+  m_deferDestruction = deferDestruction;
+}
+/// <summary>
 /// Strip all whitespace from a JSON source.
 /// </summary>
 /// <param name="source">Source of JSON.</param>
 /// <param name="destination">Destination for stripped JSON.</param>
 void JSON_Impl::stripWhiteSpace(ISource &source, IDestination &destination) {
-  while (source.more()) {
-    if (!source.isWS()) {
-      destination.add(source.current());
-      if (source.current() == '"') {
-        destination.add(extractString(source, false));
-        destination.add('"');
-        continue;
-      }
-    }
-    source.next();
+  JSON_Minifier minifier{*m_translator};
+  minifier.strip(source, destination);
+}
+/// <summary>
+/// Return true if the JNode tree may be destroyed on the reclaimer thread.
+/// That thread frees into the tree's resource while this one may still be
+/// allocating from it, so only resources that are safe to use from several
+/// threads at once qualify: new/delete, the default resource and
+/// synchronized pools. An owned resource is released along with this
+/// object so never qualifies.
+/// </summary>
+/// <returns>==true then destruction may be deferred.</returns>
+bool JSON_Impl::deferrable() const {
+  return (m_ownedResource == nullptr &&
+          (m_resource == std::pmr::new_delete_resource() ||
+           m_resource == std::pmr::get_default_resource() ||
+           dynamic_cast<std::pmr::synchronized_pool_resource *>(m_resource) !=
+               nullptr));
+}
+/// <summary>
+/// Replace the root of the JNode tree; if deferred destruction is enabled
+/// (and the tree's resource allows it) then the old tree is handed to the
+/// reclaimer thread to be destroyed.
+/// </summary>
+/// <param name="jNodeRoot">New root of JNode tree.</param>
+void JSON_Impl::replaceRoot(JNode::Ptr jNodeRoot) {
+  if (m_deferDestruction && deferrable()) {
+    JNodeReclaimer::instance().reclaim(std::move(m_jNodeRoot));
   }
+  m_jNodeRoot = std::move(jNodeRoot);
+}
+/// <summary>
+/// Build a new JNode tree and make it the root. If this object owns an arena
+/// that already holds a tree then the new tree is built in a fresh arena and
+/// the old one released along with the old tree (an arena never frees memory
+/// so re-parsing into it would otherwise grow it without bound). Each arena
+/// takes its memory through its own counter so that its footprint is known.
+/// On failure the old tree and arena are kept.
+/// </summary>
+/// <param name="build">Function that builds and returns the new tree.</param>
+template <typename Build> void JSON_Impl::buildRoot(Build build) {
+  if (!m_arena || m_jNodeRoot == nullptr) {
+    replaceRoot(build());
+    return;
+  }
+  auto counting = std::make_unique<ByteCountingResource>();
+  auto arena =
+      std::make_unique<std::pmr::monotonic_buffer_resource>(counting.get());
+  m_resource = arena.get();
+  try {
+    replaceRoot(build());
+  } catch (...) {
+    m_resource = m_ownedResource.get();
+    throw;
+  }
+  // Old arena is released into its counter before that is replaced
+  m_ownedResource = std::move(arena);
+  m_arenaCounting = std::move(counting);
 }
 // ==============
 // PUBLIC METHODS
 // ==============
 /// <summary>
+/// JSON_Impl destructor.
+/// </summary>
+JSON_Impl::~JSON_Impl() { replaceRoot(nullptr); }
+/// <summary>
 ///  Get JSONLib version.
 /// </summary>
 std::string JSON_Impl::version() {
@@ -326,6 +958,7 @@ void JSON_Impl::translator(ITranslator *translator) {
   } else {
     m_translator.reset(translator);
   }
+  m_escapeDirect = (translator == nullptr) && m_defaultConverter;
 }
 /// <summary>
 /// Set converter for JSON strings.
@@ -337,6 +970,42 @@ void JSON_Impl::converter(IConverter *converter) {
   } else {
     m_converter.reset(converter);
   }
+  m_defaultConverter = (converter == nullptr);
+}
+/// <summary>
+/// Set memory resource used to allocate the JNode tree.
+/// </summary>
+/// <param name=resource>Memory resource (nullptr for default).</param>
+void JSON_Impl::resource(std::pmr::memory_resource *resource) {
+  m_arena = false;
+  if (resource == nullptr) {
+    m_resource = std::pmr::get_default_resource();
+  } else {
+    m_resource = resource;
+  }
+}
+/// <summary>
+/// Set memory resource used to allocate the JNode tree and take ownership
+/// of it; it is then released along with the tree. Trees allocated from
+/// an owned resource are never handed to the reclaimer thread.
+/// </summary>
+/// <param name=resource>Memory resource to own.</param>
+void JSON_Impl::resource(std::unique_ptr<std::pmr::memory_resource> resource) {
+  m_ownedResource = std::move(resource);
+  this->resource(m_ownedResource.get());
+}
+/// <summary>
+/// Allocate the JNode tree from an owned monotonic arena; each parse builds
+/// its tree in a fresh arena and releases the previous one so that memory
+/// used does not grow on re-parse. What the arena takes from upstream is
+/// counted so that memory usage reports its real footprint.
+/// </summary>
+void JSON_Impl::arena() {
+  auto counting = std::make_unique<ByteCountingResource>();
+  resource(
+      std::make_unique<std::pmr::monotonic_buffer_resource>(counting.get()));
+  m_arenaCounting = std::move(counting);
+  m_arena = true;
 }
 /// <summary>
 /// Strip all whitespace from a JSON source.
@@ -344,13 +1013,109 @@ void JSON_Impl::converter(IConverter *converter) {
 /// <param name="source">Source of JSON.</param>
 /// <param name="destination">Destination for stripped JSON.</param>
 void JSON_Impl::strip(ISource &source, IDestination &destination) {
+  [[maybe_unused]] const PhaseTimer timer{m_stripTime};
+  [[maybe_unused]] std::size_t start{};
+  if constexpr (kStatistics) {
+    start = source.position();
+  }
   stripWhiteSpace(source, destination);
+  destination.flush();
+  if constexpr (kStatistics) {
+    m_bytesConsumed.fetch_add(source.position() - start,
+                              std::memory_order_relaxed);
+  }
+}
+/// <summary>
+/// Validate JSON on the source stream without building a JNode tree.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+/// <returns>Validation result (with error message and offset if invalid).</returns>
+JSON::ValidationResult JSON_Impl::validate(ISource &source) {
+  [[maybe_unused]] const PhaseTimer timer{m_validateTime};
+  [[maybe_unused]] std::size_t start{};
+  if constexpr (kStatistics) {
+    start = source.position();
+  }
+  JSON::ValidationResult result;
+  try {
+    validateJNodes(source);
+  } catch (const std::exception &e) {
+    result = JSON::ValidationResult{false, source.position(), e.what()};
+  }
+  if constexpr (kStatistics) {
+    m_bytesConsumed.fetch_add(source.position() - start,
+                              std::memory_order_relaxed);
+  }
+  return (result);
+}
+/// <summary>
+/// Return a snapshot of the statistics gathered so far.
+/// </summary>
+/// <returns>Statistics.</returns>
+JSON::Statistics JSON_Impl::stats() const {
+  JSON::Statistics statistics{m_statistics};
+  statistics.bytesConsumed = m_bytesConsumed.load(std::memory_order_relaxed);
+  statistics.parseTime =
+      std::chrono::nanoseconds{m_parseTime.load(std::memory_order_relaxed)};
+  statistics.stringifyTime = std::chrono::nanoseconds{
+      m_stringifyTime.load(std::memory_order_relaxed)};
+  statistics.stripTime =
+      std::chrono::nanoseconds{m_stripTime.load(std::memory_order_relaxed)};
+  statistics.validateTime = std::chrono::nanoseconds{
+      m_validateTime.load(std::memory_order_relaxed)};
+  return (statistics);
+}
+/// <summary>
+/// Reset statistics gathered so far.
+/// </summary>
+void JSON_Impl::resetStats() {
+  m_statistics = JSON::Statistics{kStatistics};
+  for (SharedCounter *counter : {&m_bytesConsumed, &m_parseTime,
+                                 &m_stringifyTime, &m_stripTime,
+                                 &m_validateTime}) {
+    counter->store(0, std::memory_order_relaxed);
+  }
+}
+/// <summary>
+/// Return the bytes allocated for the JNode tree broken down by use. The
+/// bytes held are taken from a counter where there is one (an owned
+/// arena's or the tree's resource itself) so that they include anything
+/// the breakdown cannot see, such as unused arena space.
+/// </summary>
+/// <returns>Memory usage.</returns>
+JSON::MemoryUsage JSON_Impl::memoryUsage() const {
+  JSON::MemoryUsage usage;
+  if (m_jNodeRoot != nullptr) {
+    measureJNodes(*m_jNodeRoot, usage);
+  }
+  if (m_arena) {
+    usage.allocatedBytes = m_arenaCounting->outstanding();
+  } else if (const auto *counting =
+                 dynamic_cast<const ByteCountingResource *>(m_resource);
+             counting != nullptr) {
+    usage.allocatedBytes = counting->outstanding();
+  } else {
+    usage.allocatedBytes = usage.total();
+  }
+  return (usage);
 }
 /// <summary>
 /// Create JNode structure by recursively parsing JSON on the source stream.
 /// </summary>
 /// <param name="source">Source of JSON.</param>
-void JSON_Impl::parse(ISource &source) { m_jNodeRoot = parseJNodes(source); }
+void JSON_Impl::parse(ISource &source) {
+  [[maybe_unused]] const PhaseTimer timer{m_parseTime};
+  [[maybe_unused]] std::size_t start{};
+  if constexpr (kStatistics) {
+    start = source.position();
+  }
+  m_depth = 0;
+  buildRoot([&] { return (parseJNodes(source)); });
+  if constexpr (kStatistics) {
+    m_bytesConsumed.fetch_add(source.position() - start,
+                              std::memory_order_relaxed);
+  }
+}
 /// <summary>
 /// Create JNode structure by recursively parsing JSON string passed.
 /// </summary>
@@ -368,7 +1133,105 @@ void JSON_Impl::stringify(IDestination &destination) {
   if (m_jNodeRoot == nullptr) {
     throw Error("No JSON to stringify.");
   }
+  [[maybe_unused]] const PhaseTimer timer{m_stringifyTime};
+  if (destination.usesReserve()) {
+    destination.reserve(estimateJNodes(*m_jNodeRoot));
+  }
   stringifyJNodes(*m_jNodeRoot, destination);
+  destination.flush();
+}
+/// <summary>
+/// Create JNode structure from its binary encoding on the source stream.
+/// </summary>
+/// <param name="source">Source of binary encoding.</param>
+void JSON_Impl::parseBinary(ISource &source) {
+  buildRoot([&] { return (JSON_Binary::decode(source, m_resource)); });
+}
+/// <summary>
+/// Write binary encoding of JNode structure to destination stream.
+/// </summary>
+/// <param name=destination>Destination stream for binary encoding.</param>
+void JSON_Impl::stringifyBinary(IDestination &destination) {
+  if (m_jNodeRoot == nullptr) {
+    throw Error("No JSON to stringify.");
+  }
+  JSON_Binary::encode(*m_jNodeRoot, destination);
+  destination.flush();
+}
+/// <summary>
+/// Recursively traverse JNode structure encoding it into JSON on the
+/// destination stream. The entries of a large root object/array are split
+/// into ranges that are stringified into separate buffers on the work
+/// stealing pool; the buffers are then added to the destination in order
+/// with a single gather write.
+/// A custom translator or converter is never called from several threads;
+/// with one the stringification is done serially.
+/// </summary>
+/// <param name=destination>Destination stream for stringified JSON.</param>
+void JSON_Impl::stringifyParallel(IDestination &destination) {
+  if (m_jNodeRoot == nullptr) {
+    throw Error("No JSON to stringify.");
+  }
+  const JNode &jNode = *m_jNodeRoot;
+  const bool object = jNode.getNodeType() == JNodeType::object;
+  std::size_t entries{};
+  if (object) {
+    entries = JNodeRef<JNodeObject>(jNode).objects().size();
+  } else if (jNode.getNodeType() == JNodeType::array &&
+             JNodeRef<JNodeArray>(jNode).packing() ==
+                 JNodeArray::Packing::none) {
+    entries = JNodeRef<JNodeArray>(jNode).array().size();
+  }
+  if (entries < kMinParallelEntries || !m_escapeDirect) {
+    stringify(destination);
+    return;
+  }
+  auto &pool = JSON_WorkStealingPool::instance();
+  [[maybe_unused]] const PhaseTimer timer{m_stringifyTime};
+  const std::size_t ranges =
+      std::min(entries, pool.threads() * kRangesPerThread);
+  std::vector<BufferDestination> buffers(ranges);
+  std::vector<std::exception_ptr> errors(ranges);
+  pool.run(ranges, [&](std::size_t range) {
+    try {
+      const std::size_t begin = range * entries / ranges;
+      const std::size_t end = (range + 1) * entries / ranges;
+      for (std::size_t entry = begin; entry < end; entry++) {
+        if (entry != begin) {
+          buffers[range].add(',');
+        }
+        if (object) {
+          auto &[key, jNodePtr] = JNodeRef<JNodeObject>(jNode).objects()[entry];
+          stringifyKey(key, buffers[range]);
+          stringifyJNodes(*jNodePtr, buffers[range]);
+        } else {
+          stringifyJNodes(*JNodeRef<JNodeArray>(jNode).array()[entry],
+                          buffers[range]);
+        }
+      }
+    } catch (...) {
+      errors[range] = std::current_exception();
+    }
+  });
+  for (auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+  // The brackets, separators and range buffers go to the destination as
+  // one gather write (a buffer destination grows once to hold them all).
+  std::vector<std::string_view> runs;
+  runs.reserve(2 * ranges + 1);
+  runs.emplace_back(object ? "{" : "[");
+  for (std::size_t range = 0; range < ranges; range++) {
+    if (range != 0) {
+      runs.emplace_back(",");
+    }
+    runs.emplace_back(buffers[range].getBuffer());
+  }
+  runs.emplace_back(object ? "}" : "]");
+  destination.add(std::span<const std::string_view>{runs});
+  destination.flush();
 }
 /// <summary>
 /// Return object entry for the passed in key.
@@ -383,13 +1246,14 @@ JNode &JSON_Impl::operator[](const std::string &key) {
   } catch ([[maybe_unused]] JNode::Error &error) {
     JNodeRef<JNodeObject>(*m_jNodeRoot)
         .objects()
-        .emplace_back(JNodeObject::ObjectEntry{key, makeHole()});
+        .emplace_back(JNodeObject::ObjectEntry{
+            std::pmr::string{key, m_resource}, makeHole(m_resource)});
     return (*JNodeRef<JNodeObject>(*m_jNodeRoot).objects().back().value);
   }
 }
 const JNode &JSON_Impl::operator[](const std::string &key) const // Object
 {
-  return ((*m_jNodeRoot)[key]);
+  return (std::as_const(*m_jNodeRoot)[key]);
 }
 /// <summary>
 /// Return array entry for the passed in index.
@@ -403,11 +1267,11 @@ JNode &JSON_Impl::operator[](std::size_t index) {
     return ((*m_jNodeRoot)[index]);
   } catch ([[maybe_unused]] JNode::Error &error) {
     JNodeRef<JNodeArray>(*m_jNodeRoot).array().resize(index + 1);
-    JNodeRef<JNodeArray>(*m_jNodeRoot).array()[index] = std::move(makeNull());
+    JNodeRef<JNodeArray>(*m_jNodeRoot).array()[index] = makeNull(m_resource);
     return (*JNodeRef<JNodeArray>(*m_jNodeRoot).array()[index]);
   }
 }
 const JNode &JSON_Impl::operator[](std::size_t index) const {
-  return ((*m_jNodeRoot)[index]);
+  return (std::as_const(*m_jNodeRoot)[index]);
 }
 } // namespace JSONLib
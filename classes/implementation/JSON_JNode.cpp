@@ -12,6 +12,10 @@
 // =================
 #include "JSON.hpp"
 #include "JSON_Types.hpp"
+// =======
+// C++ STL
+// =======
+#include <utility>
 // ====================
 // CLASS IMPLEMENTATION
 // ====================
@@ -34,71 +38,135 @@ namespace JSONLib {
 // ===============
 // PRIVATE METHODS
 // ===============
+/// <summary>
+/// Move any children of a JNode onto a list of JNodes to be destroyed.
+/// </summary>
+/// <param name="jNode">JNode whose children to move.</param>
+/// <param name="jNodes">List of JNodes to be destroyed.</param>
+static void moveChildren(JNode &jNode, std::vector<JNode::Ptr> &jNodes) {
+  if (jNode.getNodeType() == JNodeType::object) {
+    for (auto &entry : JNodeRef<JNodeObject>(jNode).objects()) {
+      jNodes.emplace_back(std::move(entry.value));
+    }
+    JNodeRef<JNodeObject>(jNode).objects().clear();
+  } else if (jNode.getNodeType() == JNodeType::array &&
+             JNodeRef<JNodeArray>(jNode).packing() ==
+                 JNodeArray::Packing::none) {
+    for (auto &entry : JNodeRef<JNodeArray>(jNode).array()) {
+      jNodes.emplace_back(std::move(entry));
+    }
+    JNodeRef<JNodeArray>(jNode).array().clear();
+  }
+}
+/// <summary>
+/// Return true if a JNode is an object or array with entries (a packed
+/// array has no JNode children other than number leaves which it frees).
+/// </summary>
+/// <param name="jNode">JNode to check.</param>
+static bool hasChildren(const JNode &jNode) {
+  return ((jNode.getNodeType() == JNodeType::object &&
+           JNodeRef<JNodeObject>(jNode).size() != 0) ||
+          (jNode.getNodeType() == JNodeType::array &&
+           JNodeRef<JNodeArray>(jNode).packing() ==
+               JNodeArray::Packing::none &&
+           JNodeRef<JNodeArray>(jNode).size() != 0));
+}
 // ==============
 // PUBLIC METHODS
 // ==============
+// =================
+// JNode destructor
+// =================
+/// <summary>
+/// Destroy a JNode and all its descendants iteratively so that very
+/// deep trees cannot overflow the stack. Children are flattened onto a
+/// list and each is destroyed only once it has no children of its own.
+/// </summary>
+JNode::~JNode() {
+  if (!hasChildren(*this)) {
+    return;
+  }
+  std::vector<JNode::Ptr> jNodes;
+  moveChildren(*this, jNodes);
+  while (!jNodes.empty()) {
+    JNode::Ptr jNode{std::move(jNodes.back())};
+    jNodes.pop_back();
+    if (jNode != nullptr) {
+      moveChildren(*jNode, jNodes);
+    }
+  }
+}
 // ==================
 // JNode constructors
 // ==================
-JNode::JNode(const std::initializer_list<InternalTypes> &list) {
-  JNodeArray jNodeArray;
+JNode::JNode(const std::initializer_list<InternalTypes> &list,
+             std::pmr::memory_resource *resource) {
+  JNodeArray jNodeArray{resource};
   for (const auto &entry : list) {
     if (const int *pint = std::get_if<int>(&entry)) {
-      jNodeArray.array().emplace_back(makeNumber(JNodeNumeric{*pint}));
+      jNodeArray.array().emplace_back(
+          makeNumber(JNodeNumeric{*pint}, resource));
     } else if (const long *plong = std::get_if<long>(&entry)) {
-      jNodeArray.array().emplace_back(makeNumber(JNodeNumeric{*plong}));
+      jNodeArray.array().emplace_back(
+          makeNumber(JNodeNumeric{*plong}, resource));
     } else if (const long long *plonglong = std::get_if<long long>(&entry)) {
-      jNodeArray.array().emplace_back(makeNumber(JNodeNumeric{*plonglong}));
+      jNodeArray.array().emplace_back(
+          makeNumber(JNodeNumeric{*plonglong}, resource));
     } else if (const float *pfloat = std::get_if<float>(&entry)) {
-      jNodeArray.array().emplace_back(makeNumber(JNodeNumeric{*pfloat}));
+      jNodeArray.array().emplace_back(
+          makeNumber(JNodeNumeric{*pfloat}, resource));
     } else if (const double *pdouble = std::get_if<double>(&entry)) {
-      jNodeArray.array().emplace_back(makeNumber(JNodeNumeric{*pdouble}));
+      jNodeArray.array().emplace_back(
+          makeNumber(JNodeNumeric{*pdouble}, resource));
     } else if (const long double *plongdouble =
                    std::get_if<long double>(&entry)) {
-      jNodeArray.array().emplace_back(makeNumber(JNodeNumeric{*plongdouble}));
+      jNodeArray.array().emplace_back(
+          makeNumber(JNodeNumeric{*plongdouble}, resource));
     } else if (const std::string *pstring = std::get_if<std::string>(&entry)) {
-      jNodeArray.array().emplace_back(makeString(*pstring));
+      jNodeArray.array().emplace_back(makeString(*pstring, resource));
     } else if (const bool *pboolean = std::get_if<bool>(&entry)) {
-      jNodeArray.array().emplace_back(makeBoolean(*pboolean));
-    } else if (const std::nullptr_t *pnull =
+      jNodeArray.array().emplace_back(makeBoolean(*pboolean, resource));
+    } else if ([[maybe_unused]] const std::nullptr_t *pnull =
                    std::get_if<std::nullptr_t>(&entry)) {
-      jNodeArray.array().emplace_back(makeNull());
+      jNodeArray.array().emplace_back(makeNull(resource));
     }
   }
-  m_jNodeVariant = std::make_unique<JNodeArray>(std::move(jNodeArray));
+  m_jNodeVariant.emplace<JNodeArray>(std::move(jNodeArray));
 }
-JNode::JNode(const std::initializer_list<
-             std::pair<std::string, InternalTypes>> &list) {
-  JNodeObject::ObjectList jObjectList;
-  JNodeObject::ObjectEntry jNodeObjectEntry;
+JNode::JNode(
+    const std::initializer_list<std::pair<std::string, InternalTypes>> &list,
+    std::pmr::memory_resource *resource) {
+  JNodeObject::ObjectList jObjectList{resource};
   for (const auto &entry : list) {
-    jNodeObjectEntry.key = entry.first;
+    JNodeObject::ObjectEntry jNodeObjectEntry{
+        std::pmr::string{entry.first, resource}, nullptr};
     if (const int *pint = std::get_if<int>(&entry.second)) {
-      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*pint});
+      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*pint}, resource);
     } else if (const long *plong = std::get_if<long>(&entry.second)) {
-      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*plong});
+      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*plong}, resource);
     } else if (const long long *plonglong =
                    std::get_if<long long>(&entry.second)) {
-      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*plonglong});
+      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*plonglong}, resource);
     } else if (const float *pfloat = std::get_if<float>(&entry.second)) {
-      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*pfloat});
+      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*pfloat}, resource);
     } else if (const double *pdouble = std::get_if<double>(&entry.second)) {
-      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*pdouble});
+      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*pdouble}, resource);
     } else if (const long double *plongdouble =
                    std::get_if<long double>(&entry.second)) {
-      jNodeObjectEntry.value = makeNumber(JNodeNumeric{*plongdouble});
+      jNodeObjectEntry.value =
+          makeNumber(JNodeNumeric{*plongdouble}, resource);
     } else if (const std::string *pstring =
                    std::get_if<std::string>(&entry.second)) {
-      jNodeObjectEntry.value = makeString(*pstring);
+      jNodeObjectEntry.value = makeString(*pstring, resource);
     } else if (const bool *pboolean = std::get_if<bool>(&entry.second)) {
-      jNodeObjectEntry.value = makeBoolean(*pboolean);
-    } else if (const std::nullptr_t *pnull =
+      jNodeObjectEntry.value = makeBoolean(*pboolean, resource);
+    } else if ([[maybe_unused]] const std::nullptr_t *pnull =
                    std::get_if<std::nullptr_t>(&entry.second)) {
-      jNodeObjectEntry.value = makeNull();
+      jNodeObjectEntry.value = makeNull(resource);
     }
     jObjectList.emplace_back(std::move(jNodeObjectEntry));
   }
-  std::swap(*this, *makeObject(jObjectList));
+  m_jNodeVariant.emplace<JNodeObject>(jObjectList);
 }
 // =====================
 // JNode index overloads 
@@ -108,9 +176,11 @@ JNode::JNode(const std::initializer_list<
 // ======
 JNode &JNode::operator[](const std::string &key) {
   if (this->getNodeType() == JNodeType::hole) {
-    this->m_jNodeVariant = std::make_unique<JNodeObject>();
+    auto *resource = getMemoryResource();
+    this->m_jNodeVariant = JNodeObject(resource);
     JNodeRef<JNodeObject>(*this).objects().emplace_back(
-        JNodeObject::ObjectEntry{key, makeHole()});
+        JNodeObject::ObjectEntry{std::pmr::string{key, resource},
+                                 makeHole(resource)});
     return (*JNodeRef<JNodeObject>(*this).objects().back().value);
   }
   return (JNodeRef<JNodeObject>(*this)[key]);
@@ -124,15 +194,16 @@ const JNode &JNode::operator[](const std::string &key) const {
 JNode &JNode::operator[](std::size_t index) {
   try {
     if (this->getNodeType() == JNodeType::hole) {
-      this->m_jNodeVariant = std::make_unique<JNodeArray>();
+      this->m_jNodeVariant = JNodeArray(getMemoryResource());
     }
     return (JNodeRef<JNodeArray>(*this)[index]);
   } catch ([[maybe_unused]] const JNode::Error &error) {
+    auto *resource = getMemoryResource();
     JNodeRef<JNodeArray>(*this).array().resize(index + 1);
-    JNodeRef<JNodeArray>(*this).array()[index] = makeHole();
+    JNodeRef<JNodeArray>(*this).array()[index] = makeHole(resource);
     for (auto &entry : JNodeRef<JNodeArray>(*this).array()) {
       if (entry == nullptr) {
-        entry = makeHole();
+        entry = makeHole(resource);
       }
     }
     return (JNodeRef<JNodeArray>(*this)[index]);
@@ -145,54 +216,251 @@ const JNode &JNode::operator[](std::size_t index) const {
 // JNode assignment operators
 // ==========================
 JNode &JNode::operator=(float floatingPoint) {
-  std::swap(*this, *makeNumber(JNodeNumeric{floatingPoint}));
+  m_jNodeVariant =
+      JNodeNumber{JNodeNumeric{floatingPoint}, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(double floatingPoint) {
-  std::swap(*this, *makeNumber(JNodeNumeric{floatingPoint}));
+  m_jNodeVariant =
+      JNodeNumber{JNodeNumeric{floatingPoint}, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(long double floatingPoint) {
-  std::swap(*this, *makeNumber(JNodeNumeric{floatingPoint}));
+  m_jNodeVariant =
+      JNodeNumber{JNodeNumeric{floatingPoint}, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(int integer) {
-  std::swap(*this, *makeNumber(JNodeNumeric{integer}));
+  m_jNodeVariant = JNodeNumber{JNodeNumeric{integer}, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(long integer) {
-  std::swap(*this, *makeNumber(JNodeNumeric{integer}));
+  m_jNodeVariant = JNodeNumber{JNodeNumeric{integer}, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(long long integer) {
-  std::swap(*this, *makeNumber(JNodeNumeric{integer}));
+  m_jNodeVariant = JNodeNumber{JNodeNumeric{integer}, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(const char *cString) {
-  std::swap(*this, *makeString(cString));
+  m_jNodeVariant = JNodeString{cString, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(const std::string &string) {
-  std::swap(*this, *makeString(string));
+  m_jNodeVariant = JNodeString{string, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=(bool boolean) {
-  std::swap(*this, *makeBoolean(boolean));
+  m_jNodeVariant = JNodeBoolean{boolean, getMemoryResource()};
   return (*this);
 }
 JNode &JNode::operator=([[maybe_unused]] std::nullptr_t null) {
-  std::swap(*this, *makeNull());
+  m_jNodeVariant = JNodeNull{getMemoryResource()};
   return (*this);
 }
-// ==============
-// Get JNode type
-// ==============
-JNodeType JNode::getNodeType() const { return (m_jNodeVariant->getNodeType()); }
-// =============================
-// Get reference to JNodeVariant
-// =============================
-std::unique_ptr<JNodeVariant> &JNode::getJNodeVariant() { return (m_jNodeVariant); }
-const std::unique_ptr<JNodeVariant> &JNode::getJNodeVariant() const {
-  return (m_jNodeVariant);
+// =========================================
+// Get memory resource used by JNode/children
+// =========================================
+std::pmr::memory_resource *JNode::getMemoryResource() const {
+  switch (getNodeType()) {
+  case JNodeType::object:
+    return (JNodeRef<JNodeObject>(*this).objects().get_allocator().resource());
+  case JNodeType::array:
+    return (JNodeRef<JNodeArray>(*this).resource());
+  case JNodeType::string:
+    return (JNodeRef<JNodeString>(*this).string().get_allocator().resource());
+  case JNodeType::number:
+    return (JNodeRef<JNodeNumber>(*this).resource());
+  case JNodeType::boolean:
+    return (JNodeRef<JNodeBoolean>(*this).resource());
+  case JNodeType::null:
+    return (JNodeRef<JNodeNull>(*this).resource());
+  case JNodeType::hole:
+    return (JNodeRef<JNodeHole>(*this).resource());
+  default:
+    return (std::pmr::get_default_resource());
+  }
+}
+// ===================
+// JNodeArray (packed)
+// ===================
+/// <summary>
+/// Construct a packed array of integers.
+/// </summary>
+/// <param name="integers">Array values.</param>
+/// <param name="resource">Memory resource for values.</param>
+JNodeArray::JNodeArray(std::span<const std::int64_t> integers,
+                       std::pmr::memory_resource *resource)
+    : m_jsonArray(resource) {
+  pack(integers, Packing::integer);
+}
+/// <summary>
+/// Construct a packed array of floating point values.
+/// </summary>
+/// <param name="floatingPoints">Array values.</param>
+/// <param name="resource">Memory resource for values.</param>
+JNodeArray::JNodeArray(std::span<const double> floatingPoints,
+                       std::pmr::memory_resource *resource)
+    : m_jsonArray(resource) {
+  pack(floatingPoints, Packing::floatingPoint);
+}
+/// <summary>
+/// Construct a packed array of single precision floating point values.
+/// </summary>
+/// <param name="floatingPoints">Array values.</param>
+/// <param name="resource">Memory resource for values.</param>
+JNodeArray::JNodeArray(std::span<const float> floatingPoints,
+                       std::pmr::memory_resource *resource)
+    : m_jsonArray(resource) {
+  pack(floatingPoints, Packing::floatingPoint32);
+}
+/// <summary>
+/// Allocate packed header plus values in one block and copy values in.
+/// </summary>
+/// <param name="values">Array values.</param>
+/// <param name="packing">Packed element type.</param>
+template <typename T>
+void JNodeArray::pack(std::span<const T> values, Packing packing) {
+  void *memory = resource()->allocate(
+      sizeof(Packed) + values.size() * sizeof(T), alignof(Packed));
+  m_packed = new (memory) Packed{packing, values.size()};
+  std::uninitialized_copy(values.begin(), values.end(),
+                          reinterpret_cast<T *>(m_packed + 1));
+}
+/// <summary>
+/// Copy another array's packed values into this array's resource.
+/// </summary>
+/// <param name="other">Packed array to copy.</param>
+void JNodeArray::pack(const JNodeArray &other) {
+  switch (other.packing()) {
+  case Packing::integer:
+    pack(other.integers(), Packing::integer);
+    break;
+  case Packing::floatingPoint:
+    pack(other.floatingPoints(), Packing::floatingPoint);
+    break;
+  case Packing::floatingPoint32:
+    pack(other.floatingPoints32(), Packing::floatingPoint32);
+    break;
+  default:
+    break;
+  }
+}
+/// <summary>
+/// Move assign an array. Packed values can only be freed through the
+/// resource they came from and the entry list keeps its own resource on
+/// move assignment, so values from another resource are copied.
+/// </summary>
+/// <param name="other">Array to move.</param>
+/// <returns>Reference to this array.</returns>
+JNodeArray &JNodeArray::operator=(JNodeArray &&other) {
+  if (this != &other) {
+    release();
+    JNodeVariant::operator=(std::move(other));
+    if (other.m_packed == nullptr) {
+      m_jsonArray = std::move(other.m_jsonArray);
+    } else {
+      m_jsonArray = ArrayList{resource()};
+      if (resource() != other.resource()) {
+        pack(other);
+        other.release();
+      } else {
+        m_packed = std::exchange(other.m_packed, nullptr);
+      }
+    }
+  }
+  return (*this);
+}
+/// <summary>
+/// Return bytes allocated for the packed header and values.
+/// </summary>
+/// <returns>Packed allocation size in bytes.</returns>
+std::size_t JNodeArray::valueBytes() const {
+  return (sizeof(Packed) +
+          m_packed->size * (m_packed->packing == Packing::floatingPoint32
+                                ? sizeof(float)
+                                : sizeof(std::uint64_t)));
+}
+/// <summary>
+/// Free any packed values.
+/// </summary>
+void JNodeArray::release() {
+  if (m_packed != nullptr) {
+    const std::size_t bytes = valueBytes();
+    m_packed->~Packed();
+    resource()->deallocate(m_packed, bytes, alignof(Packed));
+    m_packed = nullptr;
+  }
+}
+/// <summary>
+/// Return a new JNode for each packed value.
+/// </summary>
+/// <returns>Array entry list.</returns>
+JNodeArray::ArrayList JNodeArray::unpacked() const {
+  ArrayList jNodes{resource()};
+  jNodes.reserve(size());
+  for (std::size_t index = 0; index < size(); index++) {
+    jNodes.emplace_back(makeNumber(numeric(index), resource()));
+  }
+  return (jNodes);
+}
+/// <summary>
+/// Return an array element as a numeric. Packed integers take the
+/// narrowest type that holds them and packed floating point values the
+/// type they were packed as (both as when parsed unpacked).
+/// </summary>
+/// <param name="index">Element index.</param>
+/// <returns>Element numeric.</returns>
+JNodeNumeric JNodeArray::numeric(std::size_t index) const {
+  if (index >= size()) {
+    throw JNode::Error("Invalid index used to access array.");
+  }
+  switch (packing()) {
+  case Packing::integer: {
+    const std::int64_t value = integers()[index];
+    if (std::in_range<int>(value)) {
+      return (JNodeNumeric{static_cast<int>(value)});
+    }
+    if (std::in_range<long>(value)) {
+      return (JNodeNumeric{static_cast<long>(value)});
+    }
+    return (JNodeNumeric{static_cast<long long>(value)});
+  }
+  case Packing::floatingPoint:
+    return (JNodeNumeric{floatingPoints()[index]});
+  case Packing::floatingPoint32:
+    return (JNodeNumeric{floatingPoints32()[index]});
+  default:
+    return (JNodeRef<JNodeNumber>(*m_jsonArray[index]).number());
+  }
+}
+/// <summary>
+/// Return bytes allocated for packed values.
+/// </summary>
+std::size_t JNodeArray::packedBytes() const {
+  return (m_packed != nullptr ? valueBytes() : 0);
+}
+/// <summary>
+/// Return array entries; a packed array is converted to JNodes.
+/// </summary>
+JNodeArray::ArrayList &JNodeArray::array() {
+  if (m_packed != nullptr) {
+    ArrayList jNodes{unpacked()};
+    release();
+    m_jsonArray = std::move(jNodes);
+  }
+  return (m_jsonArray);
+}
+/// <summary>
+/// Return array entries. Creating JNodes for a packed array would
+/// allocate from the tree's resource (which may be shared by readers on
+/// other threads and is not synchronized), so this throws instead.
+/// </summary>
+const JNodeArray::ArrayList &JNodeArray::array() const {
+  if (m_packed != nullptr) {
+    throw JNode::Error("Packed array values cannot be accessed as JNodes "
+                       "through a const reference (use numeric()).");
+  }
+  return (m_jsonArray);
 }
 } // namespace JSONLib
@@ -0,0 +1,111 @@
+//
+// Class: JNodeReclaimer
+//
+// Description: Background reclaimer for JNode trees. Destroying a very
+// large tree can take a noticeable amount of time so when deferred
+// destruction is enabled on a JSON object its tree is handed over to
+// this class and destroyed on a separate thread instead of the caller's.
+// Note: Any memory resource used to allocate a tree must outlive its
+// reclamation and deferred destruction should not be enabled on JSON
+// objects with static storage duration.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_JNodeReclaimer.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Reclaimer thread; destroy any pending JNode trees until stopped.
+/// </summary>
+void JNodeReclaimer::reclaimer() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_pendingChanged.wait(lock,
+                          [this] { return (m_stop || !m_pending.empty()); });
+    if (m_pending.empty()) {
+      return;
+    }
+    std::vector<JNode::Ptr> jNodeRoots;
+    std::swap(jNodeRoots, m_pending);
+    m_inProgress = jNodeRoots.size();
+    lock.unlock();
+    jNodeRoots.clear();
+    lock.lock();
+    m_inProgress = 0;
+    m_pendingChanged.notify_all();
+  }
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// JNode reclaimer constructor; start reclaimer thread.
+/// </summary>
+JNodeReclaimer::JNodeReclaimer()
+    : m_thread(&JNodeReclaimer::reclaimer, this) {}
+/// <summary>
+/// JNode reclaimer destructor; destroy anything still pending and stop
+/// the reclaimer thread.
+/// </summary>
+JNodeReclaimer::~JNodeReclaimer() {
+  {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_pendingChanged.notify_all();
+  m_thread.join();
+}
+/// <summary>
+/// Return process wide JNode reclaimer.
+/// </summary>
+/// <returns>JNode reclaimer.</returns>
+JNodeReclaimer &JNodeReclaimer::instance() {
+  static JNodeReclaimer reclaimer;
+  return (reclaimer);
+}
+/// <summary>
+/// Pass a JNode tree to be destroyed on the reclaimer thread.
+/// </summary>
+/// <param name="jNodeRoot">Root of JNode tree.</param>
+void JNodeReclaimer::reclaim(JNode::Ptr jNodeRoot) {
+  if (jNodeRoot == nullptr) {
+    return;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_pending.emplace_back(std::move(jNodeRoot));
+  }
+  m_pendingChanged.notify_all();
+}
+/// <summary>
+/// Wait until all JNode trees passed to the reclaimer are destroyed.
+/// </summary>
+void JNodeReclaimer::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_pendingChanged.wait(
+      lock, [this] { return (m_pending.empty() && m_inProgress == 0); });
+}
+} // namespace JSONLib
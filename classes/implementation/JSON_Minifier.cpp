@@ -0,0 +1,151 @@
+//
+// Class: JSON_Minifier
+//
+// Description: Block based JSON whitespace stripper. The source is read a
+// block at a time and scanned (16 bytes at a time using SSE2 where
+// available) for the next byte of interest; whitespace and quotes outside
+// of strings and quotes and backslashes inside them. Everything between is
+// copied to the destination as a single run. Escapes that the translator
+// deems not valid have their backslash removed as before.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_Minifier.hpp"
+#include "JSON_Error.hpp"
+// =======
+// C++ STL
+// =======
+#include <bit>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Is character whitespace/quote (outside string) or quote/backslash
+/// (inside string).
+/// </summary>
+/// <param name="ch">Character to check.</param>
+/// <param name="inString">==true then inside a string.</param>
+/// <returns>==true then special.</returns>
+static bool isSpecial(char ch, bool inString) {
+  if (inString) {
+    return (ch == '"' || ch == '\\');
+  }
+  return (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '"');
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// JSON minifier constructor.
+/// </summary>
+/// <param name="translator">Translator used to check escapes.</param>
+JSON_Minifier::JSON_Minifier(ITranslator &translator)
+    : m_translator(translator),
+      m_block(std::make_unique_for_overwrite<char[]>(kBlockSize)) {}
+/// <summary>
+/// Find the next special character in a range of characters.
+/// </summary>
+/// <param name="begin">Start of range.</param>
+/// <param name="end">End of range.</param>
+/// <param name="inString">==true then inside a string.</param>
+/// <returns>Pointer to special character or end.</returns>
+const char *JSON_Minifier::findSpecial(const char *begin, const char *end,
+                                       bool inString) {
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i carriageReturn = _mm_set1_epi8('\r');
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+    __m128i matches = _mm_cmpeq_epi8(bytes, quote);
+    if (inString) {
+      matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, backslash));
+    } else {
+      matches = _mm_or_si128(
+          _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, space)),
+          _mm_or_si128(_mm_cmpeq_epi8(bytes, tab),
+                       _mm_or_si128(_mm_cmpeq_epi8(bytes, newline),
+                                    _mm_cmpeq_epi8(bytes, carriageReturn))));
+    }
+    if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+        mask != 0) {
+      return (begin + std::countr_zero(mask));
+    }
+  }
+#endif
+  while (begin != end && !isSpecial(*begin, inString)) {
+    begin++;
+  }
+  return (begin);
+}
+/// <summary>
+/// Strip all whitespace (outside of strings) from a JSON source.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+/// <param name="destination">Destination for stripped JSON.</param>
+void JSON_Minifier::strip(ISource &source, IDestination &destination) {
+  bool inString{false};
+  bool escaped{false};
+  for (std::size_t length = source.read(m_block.get(), kBlockSize);
+       length != 0; length = source.read(m_block.get(), kBlockSize)) {
+    const char *current = m_block.get();
+    const char *end = current + length;
+    while (current != end) {
+      // Character following a backslash (possibly in previous block)
+      if (escaped) {
+        if (m_translator.validEscape(*current)) {
+          destination.add('\\');
+        }
+        destination.add(*current++);
+        escaped = false;
+        continue;
+      }
+      const char *special = findSpecial(current, end, inString);
+      if (special != current) {
+        destination.add(current, special - current);
+        current = special;
+        continue;
+      }
+      if (*current == '"') {
+        destination.add('"');
+        inString = !inString;
+      } else if (*current == '\\') {
+        escaped = true;
+      }
+      current++;
+    }
+  }
+  if (inString) {
+    throw Error("Syntax error detected.");
+  }
+}
+} // namespace JSONLib
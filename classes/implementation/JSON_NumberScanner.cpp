@@ -0,0 +1,335 @@
+//
+// Class: JSON_NumberScanner
+//
+// Description: Fast path for converting strictly formed JSON numbers held
+// in memory. Digits are converted eight at a time (sixteen for a typical
+// coordinate) using SWAR arithmetic on 64 bit words. Decimals whose
+// digits and exponent are small enough to be held exactly are converted
+// with a single correctly rounded multiply or divide; the rest are left
+// to std::from_chars. Anything else (leading zeros or '+', integers that
+// overflow 64 bits, values out of double range) is not scanned so that
+// the general parser handles it exactly as before.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_NumberScanner.hpp"
+#include "JSON_JNodeNumeric.hpp"
+// =======
+// C++ STL
+// =======
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// Decimal digits that always fit an unsigned 64 bit mantissa
+constexpr int kMaxMantissaDigits{19};
+// Largest mantissa a double holds exactly
+constexpr std::uint64_t kMaxExactMantissa{std::uint64_t{1} << 53};
+// Powers of ten a double holds exactly
+constexpr std::array<double, 23> kExactPowersOfTen{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+// Exact operands give a correctly rounded result only for IEEE doubles
+// evaluated at double precision
+constexpr bool kExactArithmetic{std::numeric_limits<double>::is_iec559 &&
+                                FLT_EVAL_METHOD == 0};
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Is character a decimal digit.
+/// </summary>
+/// <param name="ch">Character.</param>
+static bool isDigit(char ch) { return (ch >= '0' && ch <= '9'); }
+/// <summary>
+/// Skip any whitespace in text.
+/// </summary>
+/// <param name="text">Text.</param>
+/// <param name="position">Position to skip from.</param>
+/// <returns>Position of first non whitespace character (or end).</returns>
+static std::size_t skipWS(std::string_view text, std::size_t position) {
+  while (position < text.size() &&
+         (text[position] == ' ' || text[position] == '\t' ||
+          text[position] == '\n' || text[position] == '\r')) {
+    position++;
+  }
+  return (position);
+}
+/// <summary>
+/// Accumulate a run of digits into a mantissa; digits past those that fit
+/// are counted but not accumulated.
+/// </summary>
+/// <param name="current">Start of digits.</param>
+/// <param name="end">End of text.</param>
+/// <param name="mantissa">Mantissa accumulated.</param>
+/// <param name="digits">Number of digits accumulated.</param>
+/// <returns>Pointer past the last digit.</returns>
+static const char *scanDigits(const char *current, const char *end,
+                              std::uint64_t &mantissa, int &digits) {
+  while (end - current >= 8 && digits + 8 <= kMaxMantissaDigits) {
+    const std::uint64_t word = JSON_NumberScanner::loadEight(current);
+    if (!JSON_NumberScanner::isEightDigits(word)) {
+      break;
+    }
+    mantissa = mantissa * 100000000 + JSON_NumberScanner::parseEightDigits(word);
+    current += 8;
+    digits += 8;
+  }
+  for (; current != end && isDigit(*current); current++) {
+    if (digits < kMaxMantissaDigits) {
+      mantissa = mantissa * 10 + static_cast<std::uint64_t>(*current - '0');
+    }
+    digits++;
+  }
+  return (current);
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// Load eight characters as a word with the first in its low byte.
+/// </summary>
+/// <param name="characters">Characters to load.</param>
+/// <returns>Loaded word.</returns>
+std::uint64_t JSON_NumberScanner::loadEight(const char *characters) {
+  std::uint64_t word;
+  std::memcpy(&word, characters, sizeof(word));
+  if constexpr (std::endian::native == std::endian::big) {
+    std::uint64_t swapped{};
+    for (int byte = 0; byte < 8; byte++) {
+      swapped = (swapped << 8) | ((word >> (byte * 8)) & 0xFF);
+    }
+    word = swapped;
+  }
+  return (word);
+}
+/// <summary>
+/// Are all eight characters of a word digits; the high nibbles must all
+/// be 3 both before and after adding 6 to every byte.
+/// </summary>
+/// <param name="word">Word of characters.</param>
+/// <returns>==true then all digits.</returns>
+bool JSON_NumberScanner::isEightDigits(std::uint64_t word) {
+  return (((word & 0xF0F0F0F0F0F0F0F0) |
+           (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+          0x3333333333333333);
+}
+/// <summary>
+/// Convert the eight digits held in a word; adjacent digits are combined
+/// into pairs and then the pairs into the final value using three
+/// multiplies rather than eight.
+/// </summary>
+/// <param name="word">Word of digits.</param>
+/// <returns>Value of digits.</returns>
+std::uint32_t JSON_NumberScanner::parseEightDigits(std::uint64_t word) {
+  constexpr std::uint64_t kMask{0x000000FF000000FF};
+  constexpr std::uint64_t kMultiplier1{100 + (1000000ULL << 32)};
+  constexpr std::uint64_t kMultiplier2{1 + (10000ULL << 32)};
+  word -= 0x3030303030303030;
+  word = (word * 10) + (word >> 8);
+  word = (((word & kMask) * kMultiplier1) +
+          (((word >> 16) & kMask) * kMultiplier2)) >>
+         32;
+  return (static_cast<std::uint32_t>(word));
+}
+/// <summary>
+/// Scan the number at the start of text.
+/// </summary>
+/// <param name="text">Text.</param>
+/// <param name="number">Number scanned.</param>
+/// <returns>Length of number (zero if not scanned).</returns>
+std::size_t JSON_NumberScanner::scan(std::string_view text, Number &number) {
+  const char *begin = text.data();
+  const char *end = begin + text.size();
+  const char *current = begin;
+  const bool negative{current != end && *current == '-'};
+  if (negative) {
+    current++;
+  }
+  if (current == end || !isDigit(*current)) {
+    return (0);
+  }
+  std::uint64_t mantissa{};
+  int digits{};
+  const char *integerDigits = current;
+  current = scanDigits(current, end, mantissa, digits);
+  if (*integerDigits == '0' && current - integerDigits > 1) {
+    return (0);
+  }
+  bool floatingPoint{false};
+  int exponent{};
+  if (current != end && *current == '.') {
+    floatingPoint = true;
+    const char *fractionDigits = ++current;
+    current = scanDigits(current, end, mantissa, digits);
+    if (current == fractionDigits) {
+      return (0);
+    }
+    exponent = -static_cast<int>(current - fractionDigits);
+  }
+  if (current != end && (*current == 'e' || *current == 'E')) {
+    floatingPoint = true;
+    current++;
+    const bool negativeExponent{current != end && *current == '-'};
+    if (current != end && (*current == '-' || *current == '+')) {
+      current++;
+    }
+    if (current == end || !isDigit(*current)) {
+      return (0);
+    }
+    int explicitExponent{};
+    for (; current != end && isDigit(*current); current++) {
+      if (explicitExponent < 100000) {
+        explicitExponent = explicitExponent * 10 + (*current - '0');
+      }
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+  // General parser would take further characters as part of the number
+  if (current != end && JNodeNumeric::isValidNumericChar(*current)) {
+    return (0);
+  }
+  if (!floatingPoint) {
+    if (digits > kMaxMantissaDigits ||
+        mantissa > static_cast<std::uint64_t>(
+                       std::numeric_limits<std::int64_t>::max()) +
+                       (negative ? 1 : 0)) {
+      return (0);
+    }
+    number.kind = Kind::integer;
+    number.integer = static_cast<std::int64_t>(negative ? 0 - mantissa
+                                                        : mantissa);
+  } else if (kExactArithmetic && digits <= kMaxMantissaDigits &&
+             mantissa <= kMaxExactMantissa && exponent >= -22 &&
+             exponent <= 22) {
+    number.kind = Kind::floatingPoint;
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+      value /= kExactPowersOfTen[static_cast<std::size_t>(-exponent)];
+    } else {
+      value *= kExactPowersOfTen[static_cast<std::size_t>(exponent)];
+    }
+    number.floatingPoint = negative ? -value : value;
+  } else {
+    const auto [last, error] =
+        std::from_chars(begin, current, number.floatingPoint);
+    if (error != std::errc{} || last != current) {
+      return (0);
+    }
+    number.kind = Kind::floatingPoint;
+  }
+  return (static_cast<std::size_t>(current - begin));
+}
+/// <summary>
+/// Scan a run of comma separated numbers of the same kind that ends with
+/// the closing bracket of its array.
+/// </summary>
+/// <param name="text">Text starting with the first number of the run.</param>
+/// <param name="integers">Integers scanned.</param>
+/// <param name="floatingPoints">Floating point values scanned.</param>
+/// <returns>Kind of run and its length (kind none if not scanned).</returns>
+JSON_NumberScanner::Run
+JSON_NumberScanner::scanRun(std::string_view text,
+                            std::vector<std::int64_t> &integers,
+                            std::vector<double> &floatingPoints) {
+  integers.clear();
+  floatingPoints.clear();
+  Kind kind{Kind::none};
+  std::size_t position{};
+  while (true) {
+    Number number;
+    const std::size_t length = scan(text.substr(position), number);
+    if (length == 0 || (kind != Kind::none && number.kind != kind)) {
+      return (Run{});
+    }
+    kind = number.kind;
+    if (kind == Kind::integer) {
+      integers.push_back(number.integer);
+    } else {
+      floatingPoints.push_back(number.floatingPoint);
+    }
+    position = skipWS(text, position + length);
+    if (position == text.size()) {
+      return (Run{});
+    }
+    if (text[position] == ']') {
+      return (Run{kind, position});
+    }
+    if (text[position] != ',') {
+      return (Run{});
+    }
+    position = skipWS(text, position + 1);
+  }
+}
+/// <summary>
+/// Narrow scanned floating point values to floats. Rounding the double
+/// nearest the text to a float gives the float nearest the text unless
+/// the double lies exactly halfway between two floats, so those values
+/// (and any outside the normal float range, where std::stof may report a
+/// range error) are left to the general parser.
+/// </summary>
+/// <param name="floatingPoints">Floating point values scanned.</param>
+/// <param name="floats">Values narrowed to floats.</param>
+/// <returns>true if every value was narrowed.</returns>
+bool JSON_NumberScanner::toFloats(const std::vector<double> &floatingPoints,
+                                  std::vector<float> &floats) {
+  floats.clear();
+  for (const double value : floatingPoints) {
+    if (value != 0.0 && (std::fabs(value) < FLT_MIN ||
+                         std::fabs(value) > FLT_MAX)) {
+      return (false);
+    }
+    const float narrowed = static_cast<float>(value);
+    if (static_cast<double>(narrowed) != value) {
+      const float neighbour = std::nextafter(
+          narrowed, value > narrowed ? std::numeric_limits<float>::max()
+                                     : std::numeric_limits<float>::lowest());
+      if ((static_cast<double>(narrowed) + static_cast<double>(neighbour)) /
+              2 ==
+          value) {
+        return (false);
+      }
+    }
+    floats.push_back(narrowed);
+  }
+  return (true);
+}
+/// <summary>
+/// Check that scanned floating point values are all well beyond the
+/// largest float, so std::stof fails on each and they read as doubles.
+/// </summary>
+/// <param name="floatingPoints">Floating point values scanned.</param>
+/// <returns>true if every value is out of float range.</returns>
+bool JSON_NumberScanner::beyondFloat(
+    const std::vector<double> &floatingPoints) {
+  return (std::ranges::all_of(floatingPoints, [](double value) {
+    return (std::fabs(value) >= 0x1p128);
+  }));
+}
+} // namespace JSONLib
@@ -0,0 +1,518 @@
+//
+// Class: JSON_Tape
+//
+// Description: Read optimized JSON document. Parsing produces a single
+// contiguous tape of 64 bit entries plus a string buffer rather than a
+// tree of JNodes; read only views are then used to navigate it. Each
+// container entry holds the index of its matching end entry so that a
+// whole subtree can be skipped in constant time.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_Tape.hpp"
+#include "JSON_NumberScanner.hpp"
+// =======
+// C++ STL
+// =======
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Append an entry to the tape.
+/// </summary>
+/// <param name="tag">Entry tag.</param>
+/// <param name="payload">Entry payload.</param>
+void JSON_Tape::append(Tag tag, std::uint64_t payload) {
+  m_tape.push_back(
+      (static_cast<std::uint64_t>(static_cast<unsigned char>(tag))
+       << kTagShift) |
+      (payload & kPayloadMask));
+}
+/// <summary>
+/// Extract a string from a JSON encoded source stream, translating any
+/// escapes, and append it to the string buffer and tape. Characters go
+/// straight into the string buffer after a placeholder length (patched
+/// once the string has been read); runs held in memory are copied whole.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::appendString(ISource &source) {
+  bool translateEscapes = false;
+  if (source.current() != '"') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+  const std::size_t offset = m_strings.size();
+  m_strings.append(sizeof(std::uint64_t), '\0');
+  while (source.more() && source.current() != '"') {
+    if (const auto text = source.buffered(); !text.empty()) {
+      const auto length = std::min(text.find_first_of("\"\\"), text.size());
+      if (length != 0) {
+        m_strings.append(text.substr(0, length));
+        source.skip(length);
+        continue;
+      }
+    }
+    if (source.current() == '\\') {
+      m_strings += '\\';
+      source.next();
+      translateEscapes = true;
+    }
+    m_strings += source.current();
+    source.next();
+  }
+  if (source.current() != '"') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+  if (translateEscapes) {
+    m_stringScratch.assign(m_strings, offset + sizeof(std::uint64_t));
+    m_strings.resize(offset + sizeof(std::uint64_t));
+    m_strings += m_translator.fromJSON(m_stringScratch);
+  }
+  const auto length = static_cast<std::uint64_t>(m_strings.size() - offset -
+                                                 sizeof(std::uint64_t));
+  std::memcpy(&m_strings[offset], &length, sizeof(length));
+  append(Tag::string, offset);
+}
+/// <summary>
+/// Parse a key/value pair from a JSON encoded source stream.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::parseKeyValuePair(ISource &source) {
+  source.ignoreWS();
+  appendString(source);
+  source.ignoreWS();
+  if (source.current() != ':') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+  parseValue(source);
+}
+/// <summary>
+/// Parse a number from a JSON source stream. Integers are held as a
+/// long long and anything else as a double (converted straight from the
+/// text). Numbers held in memory are converted in place by the number
+/// scanner; others (or those it leaves) are gathered into a scratch buffer
+/// and converted with std::from_chars.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::parseNumber(ISource &source) {
+  if (const auto text = source.buffered(); !text.empty()) {
+    JSON_NumberScanner::Number scanned;
+    if (const auto length = JSON_NumberScanner::scan(text, scanned);
+        length != 0) {
+      source.skip(length);
+      if (scanned.kind == JSON_NumberScanner::Kind::integer) {
+        appendInteger(scanned.integer);
+      } else {
+        appendFloatingPoint(scanned.floatingPoint);
+      }
+      return;
+    }
+  }
+  std::string &number = m_numberScratch;
+  number.clear();
+  for (; source.more() && JNodeNumeric::isValidNumericChar(source.current());
+       source.next()) {
+    number += source.current();
+  }
+  // A leading '+' is accepted (as by the JNode parser) but not by from_chars
+  const char *first = number.data();
+  const char *last = number.data() + number.size();
+  if (first != last && *first == '+' && first + 1 != last &&
+      first[1] != '-') {
+    first++;
+  }
+  long long integer{};
+  if (const auto [end, error] = std::from_chars(first, last, integer);
+      error == std::errc{} && end == last) {
+    appendInteger(integer);
+    return;
+  }
+  double value{};
+  const auto [end, error] = std::from_chars(first, last, value);
+  if (end != last || first == last) {
+    throw Error("Syntax error detected.");
+  }
+  if (error == std::errc::result_out_of_range) {
+    // Out of range values overflow to infinity/underflow as std::strtod
+    value = std::strtod(number.c_str(), nullptr);
+  } else if (error != std::errc{}) {
+    throw Error("Syntax error detected.");
+  }
+  appendFloatingPoint(value);
+}
+/// <summary>
+/// Append an integer entry and its value to the tape.
+/// </summary>
+/// <param name="integer">Integer value.</param>
+void JSON_Tape::appendInteger(long long integer) {
+  append(Tag::integer, 0);
+  m_tape.push_back(static_cast<std::uint64_t>(integer));
+}
+/// <summary>
+/// Append a floating point entry and its value to the tape.
+/// </summary>
+/// <param name="floatingPoint">Floating point value.</param>
+void JSON_Tape::appendFloatingPoint(double floatingPoint) {
+  append(Tag::floatingPoint, 0);
+  std::uint64_t bits;
+  std::memcpy(&bits, &floatingPoint, sizeof(bits));
+  m_tape.push_back(bits);
+}
+/// <summary>
+/// Parse an object from a JSON source stream.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::parseObject(ISource &source) {
+  const std::size_t start = m_tape.size();
+  std::uint64_t entries = 0;
+  append(Tag::object, 0);
+  source.next();
+  source.ignoreWS();
+  if (source.current() != '}') {
+    parseKeyValuePair(source);
+    entries++;
+    while (source.current() == ',') {
+      source.next();
+      parseKeyValuePair(source);
+      entries++;
+    }
+  }
+  if (source.current() != '}') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+  m_tape[start] |= m_tape.size();
+  append(Tag::objectEnd, entries);
+}
+/// <summary>
+/// Parse an array from a JSON source stream.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::parseArray(ISource &source) {
+  const std::size_t start = m_tape.size();
+  std::uint64_t entries = 0;
+  append(Tag::array, 0);
+  source.next();
+  source.ignoreWS();
+  if (source.current() != ']') {
+    parseValue(source);
+    entries++;
+    while (source.current() == ',') {
+      source.next();
+      parseValue(source);
+      entries++;
+    }
+  }
+  if (source.current() != ']') {
+    throw Error("Syntax error detected.");
+  }
+  source.next();
+  m_tape[start] |= m_tape.size();
+  append(Tag::arrayEnd, entries);
+}
+/// <summary>
+/// Recursively parse JSON source stream appending its entries to the tape.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::parseValue(ISource &source) {
+  source.ignoreWS();
+  switch (source.current()) {
+  case '{':
+    parseObject(source);
+    break;
+  case '[':
+    parseArray(source);
+    break;
+  case '"':
+    appendString(source);
+    break;
+  case 't':
+  case 'f':
+    if (source.match("true")) {
+      append(Tag::booleanTrue, 0);
+    } else if (source.match("false")) {
+      append(Tag::booleanFalse, 0);
+    } else {
+      throw Error("Syntax error detected.");
+    }
+    break;
+  case 'n':
+    if (!source.match("null")) {
+      throw Error("Syntax error detected.");
+    }
+    append(Tag::null, 0);
+    break;
+  case '-':
+  case '+':
+  case '0':
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    parseNumber(source);
+    break;
+  default:
+    throw Error("Syntax error detected.");
+  }
+  source.ignoreWS();
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// JSON tape constructor.
+/// </summary>
+JSON_Tape::JSON_Tape() : m_translator(m_converter) {}
+/// <summary>
+/// Parse JSON on the source stream into the tape (replacing any
+/// existing contents). If parsing fails the tape is left empty, as a
+/// partly built tape has containers without their end entries.
+/// </summary>
+/// <param name="source">Source of JSON.</param>
+void JSON_Tape::parse(ISource &source) {
+  m_tape.clear();
+  m_strings.clear();
+  try {
+    parseValue(source);
+  } catch (...) {
+    m_tape.clear();
+    m_strings.clear();
+    throw;
+  }
+}
+void JSON_Tape::parse(ISource &&source) { parse(source); }
+/// <summary>
+/// Return view of the root of the parsed document.
+/// </summary>
+/// <returns>Root view.</returns>
+JSON_Tape::View JSON_Tape::root() const {
+  if (m_tape.empty()) {
+    throw Error("No JSON has been parsed.");
+  }
+  return (View{this, 0});
+}
+/// <summary>
+/// Return the index of the entry following the value at index; for
+/// containers this skips the whole subtree in constant time.
+/// </summary>
+/// <param name="index">Tape index of value.</param>
+/// <returns>Index of next value.</returns>
+std::size_t JSON_Tape::skip(std::size_t index) const {
+  switch (tag(index)) {
+  case Tag::object:
+  case Tag::array:
+    return (payload(index) + 1);
+  case Tag::integer:
+  case Tag::floatingPoint:
+    return (index + 2);
+  default:
+    return (index + 1);
+  }
+}
+/// <summary>
+/// Return string held in string buffer for a tape string entry.
+/// </summary>
+/// <param name="index">Tape index of string.</param>
+/// <returns>View of string.</returns>
+std::string_view JSON_Tape::string(std::size_t index) const {
+  const std::size_t offset = payload(index);
+  std::uint64_t length;
+  std::memcpy(&length, &m_strings[offset], sizeof(length));
+  return (std::string_view{&m_strings[offset + sizeof(length)],
+                           static_cast<std::size_t>(length)});
+}
+// ====
+// View
+// ====
+/// <summary>
+/// Return node type of view.
+/// </summary>
+JNodeType JSON_Tape::View::getNodeType() const {
+  switch (tag()) {
+  case Tag::object:
+    return (JNodeType::object);
+  case Tag::array:
+    return (JNodeType::array);
+  case Tag::string:
+    return (JNodeType::string);
+  case Tag::integer:
+  case Tag::floatingPoint:
+    return (JNodeType::number);
+  case Tag::booleanTrue:
+  case Tag::booleanFalse:
+    return (JNodeType::boolean);
+  case Tag::null:
+    return (JNodeType::null);
+  default:
+    return (JNodeType::base);
+  }
+}
+/// <summary>
+/// Return number of entries in an object or array.
+/// </summary>
+std::size_t JSON_Tape::View::size() const {
+  if (tag() != Tag::object && tag() != Tag::array) {
+    throw JNode::Error("Node not an object or array.");
+  }
+  return (m_tape->payload(m_tape->payload(m_index)));
+}
+/// <summary>
+/// Return view of object entry for the passed in key.
+/// </summary>
+/// <param name="key">Object entry key.</param>
+JSON_Tape::View JSON_Tape::View::operator[](const std::string_view &key) const {
+  if (tag() != Tag::object) {
+    throw JNode::Error("Node not an object.");
+  }
+  for (auto entry = begin(); entry != end(); ++entry) {
+    if (entry.key() == key) {
+      return (*entry);
+    }
+  }
+  throw JNode::Error("Invalid key used to access object.");
+}
+/// <summary>
+/// Return view of array entry for the passed in index.
+/// </summary>
+/// <param name="index">Array entry index.</param>
+JSON_Tape::View JSON_Tape::View::operator[](std::size_t index) const {
+  if (tag() != Tag::array) {
+    throw JNode::Error("Node not an array.");
+  }
+  if (index >= size()) {
+    throw JNode::Error("Invalid index used to access array.");
+  }
+  auto entry = begin();
+  while (index-- > 0) {
+    ++entry;
+  }
+  return (*entry);
+}
+/// <summary>
+/// Return true if an object contains a given key.
+/// </summary>
+/// <param name="key">Object entry key.</param>
+bool JSON_Tape::View::contains(const std::string_view &key) const {
+  if (tag() != Tag::object) {
+    throw JNode::Error("Node not an object.");
+  }
+  for (auto entry = begin(); entry != end(); ++entry) {
+    if (entry.key() == key) {
+      return (true);
+    }
+  }
+  return (false);
+}
+/// <summary>
+/// Return string value.
+/// </summary>
+std::string_view JSON_Tape::View::string() const {
+  if (tag() != Tag::string) {
+    throw JNode::Error("Node not a string.");
+  }
+  return (m_tape->string(m_index));
+}
+/// <summary>
+/// Return numeric value as a long long (a double must be in range).
+/// </summary>
+long long JSON_Tape::View::getLLong() const {
+  if (tag() == Tag::integer) {
+    return (static_cast<long long>(m_tape->tape()[m_index + 1]));
+  }
+  // Bounds are exact powers of two; NaN fails both comparisons
+  const double value{getDouble()};
+  if (!(value >= -0x1p63 && value < 0x1p63)) {
+    throw JNode::Error("Number out of range for a long long.");
+  }
+  return (static_cast<long long>(value));
+}
+/// <summary>
+/// Return numeric value as a double.
+/// </summary>
+double JSON_Tape::View::getDouble() const {
+  if (tag() == Tag::integer) {
+    return (static_cast<double>(getLLong()));
+  }
+  if (tag() != Tag::floatingPoint) {
+    throw JNode::Error("Node not a number.");
+  }
+  double value;
+  std::memcpy(&value, &m_tape->tape()[m_index + 1], sizeof(value));
+  return (value);
+}
+/// <summary>
+/// Return boolean value.
+/// </summary>
+bool JSON_Tape::View::boolean() const {
+  if (tag() != Tag::booleanTrue && tag() != Tag::booleanFalse) {
+    throw JNode::Error("Node not an boolean.");
+  }
+  return (tag() == Tag::booleanTrue);
+}
+/// <summary>
+/// Return iterator to first child of object/array.
+/// </summary>
+JSON_Tape::View::Iterator JSON_Tape::View::begin() const {
+  if (tag() != Tag::object && tag() != Tag::array) {
+    throw JNode::Error("Node not an object or array.");
+  }
+  return (Iterator{m_tape, m_index + 1, tag() == Tag::object});
+}
+/// <summary>
+/// Return iterator past last child of object/array.
+/// </summary>
+JSON_Tape::View::Iterator JSON_Tape::View::end() const {
+  if (tag() != Tag::object && tag() != Tag::array) {
+    throw JNode::Error("Node not an object or array.");
+  }
+  return (Iterator{m_tape, m_tape->payload(m_index), tag() == Tag::object});
+}
+/// <summary>
+/// Return key for current object entry.
+/// </summary>
+std::string_view JSON_Tape::View::Iterator::key() const {
+  if (!m_object) {
+    throw JNode::Error("Node not an object.");
+  }
+  return (m_tape->string(m_index));
+}
+/// <summary>
+/// Move to next child skipping over any subtree.
+/// </summary>
+JSON_Tape::View::Iterator &JSON_Tape::View::Iterator::operator++() {
+  m_index = m_tape->skip(m_object ? m_index + 1 : m_index);
+  return (*this);
+}
+} // namespace JSONLib
@@ -27,9 +27,33 @@ namespace JSONLib {
 // ========================
 // PRIVATE STATIC VARIABLES
 // ========================
-static const std::vector<std::pair<const char, const char>> escapeSequences{
-    {'\\', '\\'}, {'t', '\t'}, {'"', '\"'}, {'b', '\b'},
-    {'f', '\f'},  {'n', '\n'}, {'r', '\r'}};
+// Single character escape sequences as {escape, character} pairs
+static constexpr std::array<std::pair<char, char>, 7> escapeSequences{
+    {{'\\', '\\'},
+     {'t', '\t'},
+     {'"', '\"'},
+     {'b', '\b'},
+     {'f', '\f'},
+     {'n', '\n'},
+     {'r', '\r'}}};
+// To/From escape sequence lookup tables (indexed by ASCII character, zero if
+// there is no single character escape). These are built at compile time so
+// creating a translator involves no setup and the tables can be shared
+// between any number of threads.
+static constexpr std::array<char, 128> fromEscape = [] {
+  std::array<char, 128> table{};
+  for (const auto &[key, value] : escapeSequences) {
+    table[static_cast<unsigned char>(key)] = value;
+  }
+  return (table);
+}();
+static constexpr std::array<char, 128> toEscape = [] {
+  std::array<char, 128> table{};
+  for (const auto &[key, value] : escapeSequences) {
+    table[static_cast<unsigned char>(value)] = key;
+  }
+  return (table);
+}();
 // =======================
 // PUBLIC STATIC VARIABLES
 // =======================
@@ -37,6 +61,23 @@ static const std::vector<std::pair<const char, const char>> escapeSequences{
 // PRIVATE METHODS
 // ===============
 /// <summary>
+/// Return character for a single character escape ('\0' if not one).
+/// </summary>
+/// <param name="escape">Escape character.</param>
+/// <returns>Character represented by escape.</returns>
+static char fromEscapeSequence(char escape) {
+  const auto index = static_cast<unsigned char>(escape);
+  return ((index < fromEscape.size()) ? fromEscape[index] : '\0');
+}
+/// <summary>
+/// Return escape character for a character ('\0' if it has none).
+/// </summary>
+/// <param name="utf16Char">Character to escape.</param>
+/// <returns>Escape character.</returns>
+static char toEscapeSequence(char16_t utf16Char) {
+  return ((utf16Char < toEscape.size()) ? toEscape[utf16Char] : '\0');
+}
+/// <summary>
 /// Convert \uxxxx escape sequences in a string to their correct sequence
 //  of UTF-8 characters.
 /// </summary>
@@ -68,14 +109,7 @@ char16_t decodeUTF16(std::string::const_iterator &current,
 /// JSON translator constructor.
 /// </summary>
 JSON_Translator::JSON_Translator(const IConverter &converter)
-    : m_converter(converter) {
-  // Initialise tables used to convert to/from single character
-  // escape sequences within a JSON string.
-  for (const auto &[key, value] : escapeSequences) {
-    m_fromEscape[key] = value;
-    m_toEscape[value] = key;
-  }
-}
+    : m_converter(converter) {}
 /// <summary>
 /// Check whether character is avalid escaped character or is just
 /// normal escaped ASCII character. Only a few characters are valid
@@ -86,7 +120,7 @@ JSON_Translator::JSON_Translator(const IConverter &converter)
 /// <param name="escape">Escaped character.</param>
 /// <returns>==true then character is a valid escape character.</returns>
 bool JSON_Translator::validEscape(char escape) {
-  return (m_fromEscape.contains(escape) || (escape == 'u'));
+  return ((fromEscapeSequence(escape) != '\0') || (escape == 'u'));
 }
 /// <summary>
 /// Convert any escape sequences in a string to their correct sequence
@@ -107,8 +141,9 @@ std::string JSON_Translator::fromJSON(const std::string &jsonString) {
     // Check escape sequence if characters to process
     if (current != jsonString.end()) {
       // Single character
-      if (m_fromEscape.contains(static_cast<char>(*current))) {
-        utf16Buffer += m_fromEscape[static_cast<char>(*current)];
+      if (const char character = fromEscapeSequence(*current);
+          character != '\0') {
+        utf16Buffer += character;
         current++;
       }
       // UTF16 "\uxxxx"
@@ -131,6 +166,111 @@ std::string JSON_Translator::fromJSON(const std::string &jsonString) {
   return (m_converter.toUtf8(utf16Buffer));
 }
 /// <summary>
+/// Write a UTF-8 string with the same escapes as toJSON() (using the default
+/// converter) directly into a buffer of at least escapedSize() bytes. The UTF-8 is decoded here so no intermediate UTF-16 or
+/// output strings are created.
+/// </summary>
+/// <param name="utf8String">String to escape.</param>
+/// <param name="destination">Buffer for escaped string.</param>
+/// <returns>End of escaped string or nullptr if not valid UTF-8.</returns>
+char *JSON_Translator::escape(const std::string_view &utf8String,
+                              char *destination) {
+  static const char *digits = "0123456789ABCDEF";
+  auto addUTF16 = [&destination](char16_t utf16Char) {
+    *destination++ = '\\';
+    *destination++ = 'u';
+    *destination++ = digits[(utf16Char >> 12) & 0x0f];
+    *destination++ = digits[(utf16Char >> 8) & 0x0f];
+    *destination++ = digits[(utf16Char >> 4) & 0x0f];
+    *destination++ = digits[(utf16Char)&0x0f];
+  };
+  const auto *current =
+      reinterpret_cast<const unsigned char *>(utf8String.data());
+  const auto *end = current + utf8String.size();
+  while (current != end) {
+    const unsigned char byte = *current++;
+    // ASCII
+    if (byte < 0x80) {
+      if (const char escape = toEscapeSequence(byte); escape != '\0') {
+        *destination++ = '\\';
+        *destination++ = escape;
+      } else if (byte > 0x1F) {
+        *destination++ = static_cast<char>(byte);
+      } else {
+        addUTF16(byte);
+      }
+      continue;
+    }
+    // Multi-byte sequence
+    int length{};
+    char32_t codePoint{};
+    if ((byte & 0xE0) == 0xC0) {
+      length = 1;
+      codePoint = byte & 0x1F;
+    } else if ((byte & 0xF0) == 0xE0) {
+      length = 2;
+      codePoint = byte & 0x0F;
+    } else if ((byte & 0xF8) == 0xF0) {
+      length = 3;
+      codePoint = byte & 0x07;
+    } else {
+      return (nullptr);
+    }
+    if (end - current < length) {
+      return (nullptr);
+    }
+    for (int next = 0; next < length; next++) {
+      if ((*current & 0xC0) != 0x80) {
+        return (nullptr);
+      }
+      codePoint = (codePoint << 6) | (*current++ & 0x3F);
+    }
+    // Overlong, surrogate or out of range code points are invalid
+    constexpr std::array<char32_t, 4> kMinimum{0, 0x80, 0x800, 0x10000};
+    if (codePoint < kMinimum[length] || codePoint > 0x10FFFF ||
+        (codePoint >= kHighSurrogatesBegin &&
+         codePoint <= kLowSurrogatesEnd)) {
+      return (nullptr);
+    }
+    if (codePoint >= 0x10000) {
+      codePoint -= 0x10000;
+      addUTF16(static_cast<char16_t>(kHighSurrogatesBegin + (codePoint >> 10)));
+      addUTF16(
+          static_cast<char16_t>(kLowSurrogatesBegin + (codePoint & 0x3FF)));
+    } else {
+      addUTF16(static_cast<char16_t>(codePoint));
+    }
+  }
+  return (destination);
+}
+/// <summary>
+/// Return the number of bytes escape() writes for a UTF-8 string. This is
+/// exact for valid UTF-8 and never less than escape() writes before it
+/// rejects invalid UTF-8.
+/// </summary>
+/// <param name="utf8String">String to escape.</param>
+/// <returns>Escaped size in bytes.</returns>
+std::size_t JSON_Translator::escapedSize(const std::string_view &utf8String) {
+  std::size_t size{};
+  for (const char ch : utf8String) {
+    const auto byte = static_cast<unsigned char>(ch);
+    if (byte < 0x80) {
+      if (toEscapeSequence(byte) != '\0') {
+        size += 2;
+      } else if (byte > 0x1F) {
+        size++;
+      } else {
+        size += 6;
+      }
+    } else if (byte >= 0xF0) {
+      size += 12; // Escaped surrogate pair
+    } else if (byte >= 0xC0) {
+      size += 6; // Escaped UTF-16 character
+    }
+  }
+  return (size);
+}
+/// <summary>
 /// Convert a string from raw charater values (UTF8) so that it has character
 /// escapes where applicable for its JSON form.
 /// </summary>
@@ -140,9 +280,9 @@ std::string JSON_Translator::toJSON(const std::string &utf8String) {
   std::string utf8Buffer;
   for (char16_t utf16Char : m_converter.toUtf16(utf8String)) {
     // Control characters
-    if (m_toEscape.contains(utf16Char)) {
+    if (const char escape = toEscapeSequence(utf16Char); escape != '\0') {
       utf8Buffer += '\\';
-      utf8Buffer += m_toEscape[utf16Char];
+      utf8Buffer += escape;
     }
     // ASCII
     else if ((utf16Char > 0x1F) && (utf16Char < 0x80)) {
@@ -0,0 +1,154 @@
+//
+// Class: JSON_WorkStealingPool
+//
+// Description: Persistent thread pool used to process batches of independent
+// tasks (such as parsing many small JSON documents). Each batch is split into
+// one contiguous range of indices per thread; a thread works through its own
+// range first and then steals indices from the other ranges until the batch
+// is exhausted. The calling thread takes part in each batch so a batch never
+// waits on a thread hand-off to make progress. Batches started while the
+// pool is busy (including batches nested inside a task) run inline on their
+// calling thread.
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_WorkStealingPool.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// ==true then the current thread is running a task of some batch
+thread_local bool JSON_WorkStealingPool::m_inBatch{false};
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Run tasks from a threads own queue and then steal from the others.
+/// </summary>
+/// <param name="queue">Index of threads own queue.</param>
+void JSON_WorkStealingPool::process(std::size_t queue) {
+  m_inBatch = true;
+  for (std::size_t offset = 0; offset < m_queues.size(); offset++) {
+    Queue &victim = m_queues[(queue + offset) % m_queues.size()];
+    for (std::size_t index = victim.next.fetch_add(1); index < victim.end;
+         index = victim.next.fetch_add(1)) {
+      (*m_task)(index);
+    }
+  }
+  m_inBatch = false;
+}
+/// <summary>
+/// Worker thread; wait for a batch, help process it and signal when done.
+/// </summary>
+/// <param name="queue">Index of workers own queue.</param>
+void JSON_WorkStealingPool::worker(std::size_t queue) {
+  std::size_t generation{};
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_batchStarted.wait(
+        lock, [&] { return (m_stop || m_generation != generation); });
+    if (m_stop) {
+      return;
+    }
+    generation = m_generation;
+    lock.unlock();
+    process(queue);
+    lock.lock();
+    if (--m_busy == 0) {
+      m_batchFinished.notify_all();
+    }
+  }
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// Work stealing pool constructor.
+/// </summary>
+/// <param name="threads">Number of threads (including the caller) that
+/// process a batch.</param>
+JSON_WorkStealingPool::JSON_WorkStealingPool(std::size_t threads)
+    : m_queues(std::max<std::size_t>(threads, 1)) {
+  for (std::size_t queue = 0; queue < m_queues.size() - 1; queue++) {
+    m_workers.emplace_back(&JSON_WorkStealingPool::worker, this, queue);
+  }
+}
+/// <summary>
+/// Work stealing pool destructor; stop and join worker threads.
+/// </summary>
+JSON_WorkStealingPool::~JSON_WorkStealingPool() {
+  {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_batchStarted.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+}
+/// <summary>
+/// Return process wide work stealing pool.
+/// </summary>
+/// <returns>Work stealing pool.</returns>
+JSON_WorkStealingPool &JSON_WorkStealingPool::instance() {
+  static JSON_WorkStealingPool pool;
+  return (pool);
+}
+/// <summary>
+/// Run a task for every index in [0, count) and wait until all complete.
+/// Tasks must not throw. The pool processes one batch at a time; a batch
+/// started while another is in progress (from another thread, or from
+/// within a task of the running batch) is run inline on the calling thread
+/// instead of waiting for the pool, so concurrent batches never serialise
+/// behind each other and nested batches cannot deadlock.
+/// </summary>
+/// <param name="count">Number of indices in batch.</param>
+/// <param name="task">Task to run for each index.</param>
+void JSON_WorkStealingPool::run(std::size_t count, const Task &task) {
+  std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+  // Small batches are not worth waking the workers for
+  if (count <= 1 || m_workers.empty() || m_inBatch || !runLock.try_lock()) {
+    for (std::size_t index = 0; index < count; index++) {
+      task(index);
+    }
+    return;
+  }
+  const std::size_t share = count / m_queues.size();
+  const std::size_t remainder = count % m_queues.size();
+  std::size_t begin{};
+  for (std::size_t queue = 0; queue < m_queues.size(); queue++) {
+    m_queues[queue].next = begin;
+    begin += share + (queue < remainder ? 1 : 0);
+    m_queues[queue].end = begin;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_busy = m_workers.size();
+    m_generation++;
+  }
+  m_batchStarted.notify_all();
+  process(m_queues.size() - 1);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_batchFinished.wait(lock, [this] { return (m_busy == 0); });
+  m_task = nullptr;
+}
+} // namespace JSONLib
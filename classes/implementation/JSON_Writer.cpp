@@ -0,0 +1,248 @@
+//
+// Class: JSONWriter
+//
+// Description: Streaming JSON writer. JSON is written straight to an
+// IDestination as objects, arrays, keys and values are added so that no
+// JNode tree needs to be built first. Strings are escaped with the same
+// translator and numbers formatted the same way as for stringify. In debug
+// builds the sequence of calls is checked to make sure the JSON produced is
+// well formed; in release builds only the bookkeeping needed to place commas
+// is performed (and closing a container when none is open reported).
+//
+// Dependencies:   C20++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON_Writer.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ===========================
+// PRIVATE TYPES AND CONSTANTS
+// ===========================
+#if !defined(NDEBUG)
+constexpr bool kCheckStructure{true};
+#else
+constexpr bool kCheckStructure{false};
+#endif
+// ==========================
+// PUBLIC TYPES AND CONSTANTS
+// ==========================
+// ========================
+// PRIVATE STATIC VARIABLES
+// ========================
+// =======================
+// PUBLIC STATIC VARIABLES
+// =======================
+// ===============
+// PRIVATE METHODS
+// ===============
+/// <summary>
+/// Prepare for a value to be written; adding any comma needed.
+/// </summary>
+void JSONWriter::beginValue() {
+  if (m_containers.empty()) {
+    if (kCheckStructure && m_rootWritten) {
+      throw Error("Only one top level value may be written.");
+    }
+    m_rootWritten = true;
+    return;
+  }
+  if (m_containers.back() == '{') {
+    if (kCheckStructure && !m_keyWritten) {
+      throw Error("Object value written without a key.");
+    }
+    m_keyWritten = false;
+    return;
+  }
+  if (!m_first) {
+    m_destination.add(',');
+  }
+  m_first = false;
+}
+/// <summary>
+/// Close the current container. Closing with none open is always reported
+/// as there would be nothing to pop.
+/// </summary>
+/// <param name="close">Closing character for container.</param>
+void JSONWriter::endContainer(char close) {
+  if (m_containers.empty()) {
+    throw Error("Mismatched end of object/array.");
+  }
+  if (kCheckStructure) {
+    if ((close == '}' && m_containers.back() != '{') ||
+        (close == ']' && m_containers.back() != '[')) {
+      throw Error("Mismatched end of object/array.");
+    }
+    if (m_keyWritten) {
+      throw Error("Object key written without a value.");
+    }
+  }
+  m_containers.pop_back();
+  m_first = false;
+  m_destination.add(close);
+}
+/// <summary>
+/// Add a quoted and escaped string to the destination.
+/// </summary>
+/// <param name="string">String to add.</param>
+void JSONWriter::addString(std::string_view string) {
+  if (m_escapeDirect) {
+    auto buffer =
+        m_destination.prepare(JSON_Translator::escapedSize(string) + 2);
+    buffer[0] = '"';
+    if (char *end = JSON_Translator::escape(string, &buffer[1]);
+        end != nullptr) {
+      *end++ = '"';
+      m_destination.commit(end - buffer.data());
+      return;
+    }
+    m_destination.commit(0);
+  }
+  m_destination.add('"');
+  m_destination.add(m_translator->toJSON(std::string{string}));
+  m_destination.add('"');
+}
+// ==============
+// PUBLIC METHODS
+// ==============
+/// <summary>
+/// JSON writer constructor.
+/// </summary>
+/// <param name="destination">Destination for JSON.</param>
+/// <param name="translator">Custom translator (nullptr for default).</param>
+JSONWriter::JSONWriter(IDestination &destination, ITranslator *translator)
+    : m_destination(destination) {
+  if (translator == nullptr) {
+    m_translator = std::make_unique<JSON_Translator>(m_converter);
+  } else {
+    m_translator.reset(translator);
+  }
+  m_escapeDirect = (translator == nullptr);
+}
+/// <summary>
+/// Start an object.
+/// </summary>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::beginObject() {
+  beginValue();
+  m_containers.push_back('{');
+  m_first = true;
+  m_destination.add('{');
+  return (*this);
+}
+/// <summary>
+/// End the current object.
+/// </summary>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::endObject() {
+  endContainer('}');
+  return (*this);
+}
+/// <summary>
+/// Start an array.
+/// </summary>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::beginArray() {
+  beginValue();
+  m_containers.push_back('[');
+  m_first = true;
+  m_destination.add('[');
+  return (*this);
+}
+/// <summary>
+/// End the current array.
+/// </summary>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::endArray() {
+  endContainer(']');
+  return (*this);
+}
+/// <summary>
+/// Write key of next object entry.
+/// </summary>
+/// <param name="key">Object entry key.</param>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::key(std::string_view key) {
+  if (kCheckStructure) {
+    if (m_containers.empty() || m_containers.back() != '{') {
+      throw Error("Key written outside of an object.");
+    }
+    if (m_keyWritten) {
+      throw Error("Object key written without a value.");
+    }
+  }
+  if (!m_first) {
+    m_destination.add(',');
+  }
+  m_first = false;
+  m_keyWritten = true;
+  addString(key);
+  m_destination.add(':');
+  return (*this);
+}
+/// <summary>
+/// Write string value.
+/// </summary>
+/// <param name="string">String value.</param>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::value(std::string_view string) {
+  beginValue();
+  addString(string);
+  return (*this);
+}
+/// <summary>
+/// Write C string value (null if passed nullptr).
+/// </summary>
+/// <param name="string">C string value.</param>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::value(const char *string) {
+  if (string == nullptr) {
+    return (value(nullptr));
+  }
+  return (value(std::string_view{string}));
+}
+/// <summary>
+/// Write character value as a single character string.
+/// </summary>
+/// <param name="character">Character value.</param>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::value(char character) {
+  return (value(std::string_view{&character, 1}));
+}
+/// <summary>
+/// Write boolean value.
+/// </summary>
+/// <param name="boolean">Boolean value.</param>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::value(bool boolean) {
+  beginValue();
+  m_destination.add(boolean ? "true" : "false");
+  return (*this);
+}
+/// <summary>
+/// Write null value.
+/// </summary>
+/// <returns>Reference to writer.</returns>
+JSONWriter &JSONWriter::value([[maybe_unused]] std::nullptr_t null) {
+  beginValue();
+  m_destination.add("null");
+  return (*this);
+}
+/// <summary>
+/// Flush the destination.
+/// </summary>
+void JSONWriter::flush() { m_destination.flush(); }
+/// <summary>
+/// Has a complete top level value been written ?
+/// </summary>
+/// <returns>==true then JSON written is complete.</returns>
+bool JSONWriter::complete() const {
+  return (m_rootWritten && m_containers.empty());
+}
+} // namespace JSONLib
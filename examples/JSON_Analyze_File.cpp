@@ -22,6 +22,7 @@
 // JSON
 // ====
 #include "JSON.hpp"
+#include "JSON_ByteCountingResource.hpp"
 #include "JSON_Destinations.hpp"
 #include "JSON_Sources.hpp"
 #include "JSON_Types.hpp"
@@ -51,6 +52,8 @@ struct JNodeDetails {
   std::set<std::string> unique_strings{};
   size_t maxArraySize{};
   int64_t totalArrays{};
+  int64_t totalPackedArrays{};
+  int64_t totalPackedValues{};
   size_t maxObjectSize{};
   int64_t totalObjects{};
 };
@@ -71,6 +74,7 @@ std::string prefixTestDataPath(const std::string &file) {
 /// <param name="jNodeDetails">result of JNode tree analysis</param>
 void outputAnalysis(const JNodeDetails &jNodeDetails) {
   PLOG_INFO << "--------------------JNode Sizes---------------------";
+  PLOG_INFO << "JNode size " << sizeof(JNode) << " in bytes.";
   PLOG_INFO << "JNodeObject size " << sizeof(JNodeObject) << " in bytes.";
   PLOG_INFO << "JNodeArray size " << sizeof(JNodeArray) << " in bytes.";
   PLOG_INFO << "JNodeNumeric size " << sizeof(JNodeNumeric) << " in bytes.";
@@ -89,6 +93,9 @@ void outputAnalysis(const JNodeDetails &jNodeDetails) {
             << " unique strings.";
   PLOG_INFO << "JNode Tree contains " << jNodeDetails.totalArrays << " arrays.";
   PLOG_INFO << "JNode Tree max array size " << jNodeDetails.maxArraySize << ".";
+  PLOG_INFO << "JNode Tree contains " << jNodeDetails.totalPackedArrays
+            << " packed arrays (" << jNodeDetails.totalPackedValues
+            << " numbers).";
   PLOG_INFO << "JNode Tree contains " << jNodeDetails.totalObjects
             << " objects.";
   PLOG_INFO << "JNode Tree max object size " << jNodeDetails.maxObjectSize
@@ -109,7 +116,7 @@ void analyzeJNode(const JNode &jNode, JNodeDetails &jNodeDetails) {
   case JNodeType::string:
     jNodeDetails.sizeInBytes += sizeof(JNodeString);
     jNodeDetails.sizeInBytes += JNodeRef<JNodeString>(jNode).string().size();
-    jNodeDetails.unique_strings.insert(JNodeRef<JNodeString>(jNode).string());
+    jNodeDetails.unique_strings.insert(JNodeRef<JNodeString>(jNode).toString());
     jNodeDetails.totalStrings++;
     break;
   case JNodeType::boolean:
@@ -126,7 +133,7 @@ void analyzeJNode(const JNode &jNode, JNodeDetails &jNodeDetails) {
                  jNodeDetails.maxObjectSize);
     for (auto &[key, jNodePtr] : JNodeRef<JNodeObject>(jNode).objects()) {
       analyzeJNode(JNodeRef<JNodeObject>(jNode)[key], jNodeDetails);
-      jNodeDetails.unique_keys.insert(key);
+      jNodeDetails.unique_keys.insert(std::string{key});
       jNodeDetails.sizeInBytes += key.size();
       jNodeDetails.sizeInBytes += sizeof(JNodeObject::ObjectEntry);
       jNodeDetails.totalKeys++;
@@ -138,6 +145,13 @@ void analyzeJNode(const JNode &jNode, JNodeDetails &jNodeDetails) {
     jNodeDetails.totalArrays++;
     jNodeDetails.maxArraySize =
         std::max(JNodeRef<JNodeArray>(jNode).size(), jNodeDetails.maxArraySize);
+    if (JNodeRef<JNodeArray>(jNode).packing() != JNodeArray::Packing::none) {
+      jNodeDetails.totalPackedArrays++;
+      jNodeDetails.totalPackedValues += JNodeRef<JNodeArray>(jNode).size();
+      jNodeDetails.sizeInBytes +=
+          JNodeRef<JNodeArray>(jNode).size() * sizeof(std::int64_t);
+      break;
+    }
     for (auto &bNodeEntry : JNodeRef<JNodeArray>(jNode).array()) {
       analyzeJNode(*bNodeEntry, jNodeDetails);
       jNodeDetails.sizeInBytes += sizeof(JNode::Ptr);
@@ -165,9 +179,21 @@ void analyzeJNodeTree(const JNode &jNodeRoot) {
 void processJSONFile(const std::string &fileName) {
   std::cout << "Analyzing " << fileName << "\n";
   PLOG_INFO << "Analyzing " << fileName;
-  const JSON json;
+  // Tree allocations are counted so the bytes it holds are tracked
+  ByteCountingResource counting;
+  const JSON json{nullptr, nullptr, &counting};
   json.parse(FileSource{fileName});
   analyzeJNodeTree(json.root());
+  const auto usage = json.memoryUsage();
+  PLOG_INFO << "-----------------JNode Tree Memory------------------";
+  PLOG_INFO << "JNode Tree allocated " << usage.allocatedBytes << " bytes.";
+  PLOG_INFO << "Nodes " << usage.nodeBytes << " bytes (" << usage.nodes
+            << " nodes).";
+  PLOG_INFO << "Containers " << usage.containerBytes << " bytes ("
+            << usage.containerUnusedBytes << " unused).";
+  PLOG_INFO << "Keys " << usage.keyBytes << " bytes.";
+  PLOG_INFO << "Strings " << usage.stringBytes << " bytes.";
+  PLOG_INFO << "Numbers " << usage.numberBytes << " bytes.";
   PLOG_INFO << "Finished " << fileName << ".";
   std::cout << "Finished " << fileName << ".\n";
 }
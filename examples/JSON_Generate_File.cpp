@@ -0,0 +1,103 @@
+//
+// Program: JSON_Generate_File
+//
+// Description: Generate a synthetic JSON file of a given shape and size
+// from a seed; the same arguments always produce the same file so that
+// performance measurements can be reproduced without shipping large test
+// data (e.g. large-file.json used by JSON_Parse_File).
+//
+// Usage: JSON_Generate_File file [--shape records|numeric|nested|escapes|wide]
+//                                [--size bytes[K|M|G]] [--seed number]
+//
+// Dependencies: C20++, JSONLib.
+//
+// =============
+// INCLUDE FILES
+// =============
+// =======
+// C++ STL
+// =======
+#include <cstdlib>
+#include <iostream>
+#include <string>
+// ====
+// JSON
+// ====
+#include "JSON_Destinations.hpp"
+#include "JSON_Generator.hpp"
+// ====================
+// JSON class namespace
+// ====================
+using namespace JSONLib;
+// ========================
+// LOCAL TYPES/DEFINITIONS
+// ========================
+// ===============
+// LOCAL FUNCTIONS
+// ===============
+/// <summary>
+/// Convert a size with an optional K/M/G suffix to bytes.
+/// </summary>
+/// <param name="size">Size text.</param>
+/// <returns>Size in bytes.</returns>
+static std::uint64_t parseSize(const std::string &size) {
+  std::size_t end{};
+  std::uint64_t bytes = std::stoull(size, &end);
+  if (end < size.size()) {
+    switch (size[end]) {
+    case 'G':
+    case 'g':
+      bytes *= 1024;
+      [[fallthrough]];
+    case 'M':
+    case 'm':
+      bytes *= 1024;
+      [[fallthrough]];
+    case 'K':
+    case 'k':
+      bytes *= 1024;
+      break;
+    default:
+      throw std::runtime_error("Invalid size '" + size + "'.");
+    }
+  }
+  return (bytes);
+}
+// ============================
+// ===== MAIN ENTRY POINT =====
+// ============================
+int main(int argc, char **argv) {
+  try {
+    if (argc < 2 || argc % 2 != 0) {
+      std::cerr << "Usage: " << argv[0]
+                << " file [--shape records|numeric|nested|escapes|wide]"
+                   " [--size bytes[K|M|G]] [--seed number]\n";
+      exit(EXIT_FAILURE);
+    }
+    JSON_Generator::Shape shape{JSON_Generator::Shape::records};
+    std::uint64_t size{1024 * 1024};
+    std::uint64_t seed{JSON_Generator::kDefaultSeed};
+    for (int argument = 2; argument < argc; argument += 2) {
+      const std::string option{argv[argument]};
+      const std::string value{argv[argument + 1]};
+      if (option == "--shape") {
+        shape = JSON_Generator::shape(value);
+      } else if (option == "--size") {
+        size = parseSize(value);
+      } else if (option == "--seed") {
+        seed = std::stoull(value);
+      } else {
+        throw std::runtime_error("Unknown option " + option + ".");
+      }
+    }
+    JSON_Generator generator{shape, seed};
+    const auto written = generator.generate(size, FileDestination{argv[1]});
+    std::cout << "Generated " << written << " bytes of "
+              << JSON_Generator::name(shape) << " JSON in " << argv[1]
+              << ".\n";
+  } catch (const std::exception &ex) {
+    std::cerr << ex.what() << "\n";
+    exit(EXIT_FAILURE);
+  }
+  exit(EXIT_SUCCESS);
+}
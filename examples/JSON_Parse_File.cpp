@@ -91,6 +91,17 @@ void processJSONFile(const std::string &fileName) {
   PLOG_INFO << "Took " << parsedTime.count()
             << " microseconds to parse from buffer.";
   //
+  // Display statistics gathered by the library
+  //
+  if (const auto &stats = json.stats(); stats.enabled) {
+    PLOG_INFO << "Parsed " << stats.bytesConsumed << " bytes: "
+              << stats.objects << " objects, " << stats.arrays << " arrays, "
+              << stats.strings << " strings, " << stats.numbers
+              << " numbers, " << stats.booleans << " booleans, "
+              << stats.nulls << " nulls (max depth " << stats.maxDepth
+              << ").";
+  }
+  //
   // Display contents
   //
   if (jsonDestination.getBuffer().size() < kMaxFileLengthToDisplay) {
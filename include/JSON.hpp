@@ -2,7 +2,12 @@
 // =======
 // C++ STL
 // =======
+#include <chrono>
+#include <cstdint>
+#include <exception>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -27,11 +32,78 @@ public:
   // ==========================
   // PUBLIC TYPES AND CONSTANTS
   // ==========================
+  // Result of validating JSON (offset is the source position of any error)
+  struct ValidationResult {
+    bool valid{true};
+    std::size_t offset{};
+    std::string message;
+    explicit operator bool() const { return (valid); }
+  };
+  // Result of parsing one document of a batch (json is null and error and
+  // message hold what was thrown if it did not parse)
+  struct BatchResult {
+    std::unique_ptr<JSON> json;
+    std::exception_ptr error;
+    std::string message;
+    explicit operator bool() const { return (json != nullptr); }
+  };
+  // Statistics accumulated since construction or the last resetStats()
+  // (all zero when statistics are turned off at compile time)
+  struct Statistics {
+    bool enabled{};
+    // Bytes consumed from sources by parse/validate/strip
+    std::uint64_t bytesConsumed{};
+    // Nodes parsed by type
+    std::uint64_t objects{};
+    std::uint64_t arrays{};
+    std::uint64_t strings{};
+    std::uint64_t numbers{};
+    std::uint64_t booleans{};
+    std::uint64_t nulls{};
+    // Deepest object/array nesting parsed
+    std::uint64_t maxDepth{};
+    // Strings (and keys) parsed that contained escapes
+    std::uint64_t escapedStrings{};
+    // Numbers parsed that did not fit an int and fell back to a wider
+    // integer or floating point type
+    std::uint64_t numericFallbacks{};
+    // Time spent in each phase
+    std::chrono::nanoseconds parseTime{};
+    std::chrono::nanoseconds stringifyTime{};
+    std::chrono::nanoseconds stripTime{};
+    std::chrono::nanoseconds validateTime{};
+  };
+  // Bytes allocated for the JNode tree from its memory resource. The
+  // breakdown is measured by walking the tree; allocatedBytes is tracked by
+  // counting allocations where the library can see them (the whole
+  // footprint of an arena it owns, or a ByteCountingResource passed in as
+  // the tree's resource) and is the breakdown total otherwise.
+  struct MemoryUsage {
+    // JNodes (each node holds its variant inline)
+    std::size_t nodes{};
+    std::size_t nodeBytes{};
+    // Object entry/array element storage (allocated capacity) and how
+    // much of it is currently unused
+    std::size_t containerBytes{};
+    std::size_t containerUnusedBytes{};
+    // Key and string value characters too long to be held inline
+    std::size_t keyBytes{};
+    std::size_t stringBytes{};
+    // Numbers too large to be held inline
+    std::size_t numberBytes{};
+    // Bytes held for the tree as tracked by counting allocations
+    std::size_t allocatedBytes{};
+    [[nodiscard]] std::size_t total() const {
+      return (nodeBytes + containerBytes + keyBytes + stringBytes +
+              numberBytes);
+    }
+  };
   // ======================
   // CONSTRUCTOR/DESTRUCTOR
   // ======================
   explicit JSON(ITranslator *translator = nullptr,
-                IConverter *converter = nullptr);
+                IConverter *converter = nullptr,
+                std::pmr::memory_resource *resource = nullptr);
   explicit JSON(const std::string &jsonString);
   JSON(const JSON &other) = delete;
   JSON &operator=(const JSON &other) = delete;
@@ -44,12 +116,27 @@ public:
   [[nodiscard]] std::string version() const;
   void parse(ISource &source) const;
   void parse(ISource &&source) const;
+  static std::vector<BatchResult>
+  parseBatch(std::span<ISource *const> sources);
+  [[nodiscard]] ValidationResult validate(ISource &source) const;
+  [[nodiscard]] ValidationResult validate(ISource &&source) const;
   void stringify(IDestination &destination) const;
   void stringify(IDestination &&destination) const;
+  void stringifyParallel(IDestination &destination) const;
+  void stringifyParallel(IDestination &&destination) const;
+  void parseBinary(ISource &source) const;
+  void parseBinary(ISource &&source) const;
+  void stringifyBinary(IDestination &destination) const;
+  void stringifyBinary(IDestination &&destination) const;
   void strip(ISource &source, IDestination &destination) const;
   void strip(ISource &source, IDestination &&destination) const;
   void strip(ISource &&source, IDestination &destination) const;
   void strip(ISource &&source, IDestination &&destination) const;
+  void deferDestruction(bool deferDestruction) const;
+  [[nodiscard]] Statistics stats() const;
+  [[nodiscard]] MemoryUsage memoryUsage() const;
+  void resetStats() const;
+  static void flushDestruction();
   [[nodiscard]] JNode &root();
   [[nodiscard]] const JNode &root() const;
   JNode &operator[](const std::string &key);
@@ -0,0 +1,91 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+// =============================
+// Source/Destination interfaces
+// =============================
+#include "IDestination.hpp"
+#include "ISource.hpp"
+// ====
+// JSON
+// ====
+#include "JSON_Types.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_Binary {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // ==================
+  // JSON binary error
+  // ==================
+  struct Error : public std::runtime_error {
+    explicit Error(const std::string &message)
+        : std::runtime_error("JSON Binary Error: " + message) {}
+  };
+  // ======================================================================
+  // Encoding: a four byte header followed by the root node. Each node is
+  // a one byte tag followed by its payload. Counts and lengths are LEB128
+  // variable length integers; fixed size numbers are little endian. Packed
+  // arrays are held as a count followed by their raw values.
+  // ======================================================================
+  static constexpr std::string_view kMagic{"JNB1"};
+  enum class Tag : char {
+    object = '{',              // count, count x (key length, key bytes, node)
+    array = '[',               // count, count x node
+    string = '"',              // length, bytes
+    integer = 'i',             // 4 bytes
+    longInteger = 'l',         // 8 bytes
+    llong = 'L',               // 8 bytes
+    floatingPoint = 'f',       // 4 bytes (IEEE 754 binary32)
+    doubleFloatingPoint = 'd', // 8 bytes (IEEE 754 binary64)
+    ldouble = 'D',             // length, shortest round trip text
+    booleanTrue = 't',
+    booleanFalse = 'F',
+    null = 'n',
+    integerArray = 'I',            // count, count x 8 bytes
+    floatingPointArray = 'P',      // count, count x 4 bytes (binary32)
+    doubleFloatingPointArray = 'Q' // count, count x 8 bytes (binary64)
+  };
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  JSON_Binary() = delete;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  static void encode(const JNode &jNode, IDestination &destination);
+  static JNode::Ptr decode(ISource &source,
+                           std::pmr::memory_resource *resource =
+                               std::pmr::get_default_resource());
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  static void encodeJNodes(const JNode &jNode, IDestination &destination);
+  static void encodeNumber(const JNodeNumeric &number,
+                           IDestination &destination);
+  static JNode::Ptr decodeJNodes(ISource &source,
+                                 std::pmr::memory_resource *resource);
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+};
+} // namespace JSONLib
@@ -0,0 +1,78 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class ByteCountingResource : public std::pmr::memory_resource {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  explicit ByteCountingResource(
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : m_upstream(upstream) {}
+  ByteCountingResource(const ByteCountingResource &other) = delete;
+  ByteCountingResource &operator=(const ByteCountingResource &other) = delete;
+  ByteCountingResource(ByteCountingResource &&other) = delete;
+  ByteCountingResource &operator=(ByteCountingResource &&other) = delete;
+  ~ByteCountingResource() override = default;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  // Bytes allocated in total and those not yet deallocated
+  [[nodiscard]] std::size_t allocated() const {
+    return (m_allocated.load(std::memory_order_relaxed));
+  }
+  [[nodiscard]] std::size_t outstanding() const {
+    return (m_outstanding.load(std::memory_order_relaxed));
+  }
+  [[nodiscard]] std::pmr::memory_resource *upstream() const {
+    return (m_upstream);
+  }
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *memory = m_upstream->allocate(bytes, alignment);
+    m_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    m_outstanding.fetch_add(bytes, std::memory_order_relaxed);
+    return (memory);
+  }
+  void do_deallocate(void *memory, std::size_t bytes,
+                     std::size_t alignment) override {
+    m_upstream->deallocate(memory, bytes, alignment);
+    m_outstanding.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+  [[nodiscard]] bool
+  do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return (this == &other);
+  }
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Resource requests are passed on to
+  std::pmr::memory_resource *m_upstream;
+  // Byte counts (atomic as a tree may be freed on another thread)
+  std::atomic<std::size_t> m_allocated{};
+  std::atomic<std::size_t> m_outstanding{};
+};
+} // namespace JSONLib
@@ -7,6 +7,7 @@
 #else
 #include <codecvt>
 #include <locale>
+#include <mutex>
 #endif
 // ===================
 // Converter interface
@@ -46,9 +47,12 @@ private:
   // PRIVATE VARIABLES
   // =================
 #if !defined(_WIN64)
-  inline static std::wstring_convert<std::codecvt_utf8_utf16<char16_t>,
-                                     char16_t>
+  // Conversion state is held per converter (so per JSON instance). The
+  // parallel stringify may fall back to the translator from several pool
+  // threads, so the state is guarded.
+  mutable std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
       m_UTF16;
+  mutable std::mutex m_UTF16Mutex;
 #endif
 };
 // ============================================================
@@ -2,8 +2,14 @@
 // =======
 // C++ STL
 // =======
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 // =====================
 // Destination interface
 // =====================
@@ -21,37 +27,157 @@ namespace JSONLib {
 class BufferDestination : public IDestination {
 public:
   BufferDestination() = default;
+  explicit BufferDestination(std::size_t capacity) { reserve(capacity); }
   void add(const std::string &bytes) override {
-    for (auto b : bytes) {
-      m_stringifyBuffer.push_back(b);
-    }
+    m_stringifyBuffer.append(bytes);
   }
   void add(const char ch) override { m_stringifyBuffer.push_back(ch); }
+  void add(const char *bytes, std::size_t length) override {
+    m_stringifyBuffer.append(bytes, length);
+  }
+  // Grow the buffer once for all of the runs
+  void add(std::span<const std::string_view> runs) override {
+    std::size_t size{};
+    for (const auto &run : runs) {
+      size += run.size();
+    }
+    reserve(size);
+    for (const auto &run : runs) {
+      m_stringifyBuffer.append(run);
+    }
+  }
+  void append(const std::string_view &bytes) {
+    m_stringifyBuffer.append(bytes);
+  }
+  void append(const char *bytes, std::size_t length) {
+    m_stringifyBuffer.append(bytes, length);
+  }
   void clear() override { m_stringifyBuffer.clear(); }
-  [[nodiscard]] std::string getBuffer() const { return (m_stringifyBuffer); }
+  void reserve(std::size_t size) override {
+    m_stringifyBuffer.reserve(m_stringifyBuffer.size() + size);
+  }
+  [[nodiscard]] bool usesReserve() const override { return (true); }
+  // The prepared span is only part of the buffer until commit() trims it
+  // back to the bytes written, so nothing may read the buffer in between.
+  // Growing a string with resize() value-initialises the new bytes, an
+  // extra pass over every prepared byte; C++23 can grow it without, but
+  // under C++20 that cost is kept rather than staging the bytes elsewhere
+  // (which would need another allocation per destination plus a copy).
+  std::span<char> prepare(std::size_t size) override {
+    m_preparedAt = m_stringifyBuffer.size();
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    m_stringifyBuffer.resize_and_overwrite(
+        m_preparedAt + size,
+        []([[maybe_unused]] char *buffer, std::size_t length) {
+          return (length);
+        });
+#else
+    m_stringifyBuffer.resize(m_preparedAt + size);
+#endif
+    return (std::span<char>{&m_stringifyBuffer[m_preparedAt], size});
+  }
+  void commit(std::size_t length) override {
+    m_stringifyBuffer.resize(m_preparedAt + length);
+  }
+  [[nodiscard]] std::size_t size() const { return (m_stringifyBuffer.size()); }
+  [[nodiscard]] std::size_t capacity() const {
+    return (m_stringifyBuffer.capacity());
+  }
+  [[nodiscard]] const std::string &getBuffer() const & {
+    return (m_stringifyBuffer);
+  }
+  [[nodiscard]] std::string getBuffer() && {
+    return (std::move(m_stringifyBuffer));
+  }
+  // Move out buffer contents leaving the destination empty
+  [[nodiscard]] std::string release() {
+    std::string buffer{std::move(m_stringifyBuffer)};
+    m_stringifyBuffer.clear();
+    return (buffer);
+  }
 
 private:
+  // Buffer (sized to the bytes added)
   std::string m_stringifyBuffer;
+  // Offset of the span returned by prepare()
+  std::size_t m_preparedAt{};
 };
 // ====
 // File
 // ====
 class FileDestination : public IDestination {
 public:
-  explicit FileDestination(const std::string &destinationFileName)
-      : m_destinationFileName(destinationFileName) {
+  // Default size of write buffer
+  static constexpr std::size_t kDefaultBufferSize{64 * 1024};
+  explicit FileDestination(const std::string &destinationFileName,
+                           std::size_t bufferSize = kDefaultBufferSize)
+      : m_destinationFileName(destinationFileName),
+        m_bufferSize(std::max<std::size_t>(bufferSize, 1)),
+        m_buffer(std::make_unique_for_overwrite<char[]>(m_bufferSize)) {
+    // Buffering is done here so stream is unbuffered
+    m_destination.rdbuf()->pubsetbuf(nullptr, 0);
     m_destination.open(destinationFileName.c_str(), std::ios_base::binary);
     clear();
   }
+  FileDestination(const FileDestination &other) = delete;
+  FileDestination &operator=(const FileDestination &other) = delete;
+  FileDestination(FileDestination &&other) = delete;
+  FileDestination &operator=(FileDestination &&other) = delete;
+  ~FileDestination() override {
+    // Write errors are reported by the flush() that ends a stringify; one
+    // here cannot be thrown out of the destructor.
+    try {
+      flush();
+    } catch (...) {
+    }
+  }
   void add(const std::string &bytes) override {
-    m_destination.write(bytes.c_str(), bytes.length());
-    m_destination.flush();
+    add(bytes.c_str(), bytes.length());
+  }
+  void add(const char *bytes, std::size_t length) override {
+    if (m_used + length > m_bufferSize) {
+      writeBuffer();
+    }
+    if (length >= m_bufferSize) {
+      write(bytes, length);
+    } else {
+      std::memcpy(&m_buffer[m_used], bytes, length);
+      m_used += length;
+    }
   }
   void add(const char ch) override {
-    m_destination.put(ch);
+    if (m_used == m_bufferSize) {
+      writeBuffer();
+    }
+    m_buffer[m_used++] = ch;
+  }
+  void flush() override {
+    writeBuffer();
     m_destination.flush();
+    if (!m_destination) {
+      throw Error("File output stream failed to flush to file.");
+    }
+  }
+  std::span<char> prepare(std::size_t size) override {
+    // Too big for write buffer so use the default scratch space
+    m_preparedInScratch = size > m_bufferSize;
+    if (m_preparedInScratch) {
+      return (IDestination::prepare(size));
+    }
+    if (m_used + size > m_bufferSize) {
+      writeBuffer();
+    }
+    return (std::span<char>{&m_buffer[m_used], size});
+  }
+  void commit(std::size_t length) override {
+    if (m_preparedInScratch) {
+      IDestination::commit(length);
+    } else {
+      m_used += length;
+    }
   }
   void clear() override {
+    m_used = 0;
     if (m_destination.is_open()) {
       m_destination.close();
     }
@@ -63,7 +189,19 @@ public:
   }
 
 private:
+  void writeBuffer() { write(m_buffer.get(), std::exchange(m_used, 0)); }
+  void write(const char *bytes, std::size_t length) {
+    m_destination.write(bytes, static_cast<std::streamsize>(length));
+    if (!m_destination) {
+      throw Error("File output stream failed to write to file.");
+    }
+  }
   std::ofstream m_destination;
   std::string m_destinationFileName;
+  std::size_t m_bufferSize;
+  // Write buffer (allocated once and not initialised) and bytes used in it
+  std::unique_ptr<char[]> m_buffer;
+  std::size_t m_used{};
+  bool m_preparedInScratch{};
 };
 } // namespace JSONLib
\ No newline at end of file
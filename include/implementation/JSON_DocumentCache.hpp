@@ -0,0 +1,118 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+// ====
+// JSON
+// ====
+#include "JSON.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class DocumentCache {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // ====================
+  // Document cache error
+  // ====================
+  struct Error : public std::runtime_error {
+    explicit Error(const std::string &message)
+        : std::runtime_error("DocumentCache Error: " + message) {}
+  };
+  // Root of a parsed document shared between all users; only a read-only
+  // JNode is handed out so the shared JSON cannot be reparsed or changed
+  using Document = std::shared_ptr<const JNode>;
+  // Identity of a file's contents; any change means a reload
+  struct FileIdentity {
+    std::uint64_t inode{};
+    std::int64_t modified{};
+    std::uint64_t size{};
+    bool operator==(const FileIdentity &other) const = default;
+  };
+  static constexpr std::size_t kDefaultMemoryBudget{256 * 1024 * 1024};
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  explicit DocumentCache(
+      std::size_t memoryBudget = kDefaultMemoryBudget,
+      std::chrono::milliseconds revalidateInterval = std::chrono::milliseconds{0});
+  DocumentCache(const DocumentCache &other) = delete;
+  DocumentCache &operator=(const DocumentCache &other) = delete;
+  DocumentCache(DocumentCache &&other) = delete;
+  DocumentCache &operator=(DocumentCache &&other) = delete;
+  ~DocumentCache();
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  Document get(const std::string &fileName);
+  void erase(const std::string &fileName);
+  void clear();
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] std::size_t memoryUsed() const;
+  [[nodiscard]] std::size_t loads() const;
+  static FileIdentity identity(const std::string &fileName);
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // Cache entry (document is shared with any threads waiting on its load)
+  struct Entry {
+    FileIdentity identity;
+    std::shared_future<Document> document;
+    std::uint64_t generation{};
+    std::size_t bytes{};
+    std::list<std::string>::iterator lru;
+  };
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  Document load(const std::string &fileName, std::size_t &bytes);
+  void loaded(const std::string &fileName, std::uint64_t generation,
+              std::size_t bytes, bool failed);
+  void reloaded(const std::string &fileName, std::uint64_t generation,
+                const FileIdentity &fileIdentity, Document document,
+                std::size_t bytes);
+  Document cached(Entry &entry, std::unique_lock<std::mutex> &lock);
+  void evict();
+  void remove(std::unordered_map<std::string, Entry>::iterator entry);
+  void revalidator();
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Cached entries and their least recently used order (front is newest)
+  std::unordered_map<std::string, Entry> m_entries;
+  std::list<std::string> m_lru;
+  // Memory budget and current usage of cached documents
+  std::size_t m_memoryBudget;
+  std::size_t m_memoryUsed{};
+  // Number of documents loaded and next load generation
+  std::size_t m_loads{};
+  std::uint64_t m_generation{};
+  // Background revalidation
+  std::chrono::milliseconds m_revalidateInterval;
+  bool m_stop{};
+  std::condition_variable m_stopChanged;
+  mutable std::mutex m_mutex;
+  std::thread m_thread;
+};
+} // namespace JSONLib
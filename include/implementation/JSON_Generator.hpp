@@ -0,0 +1,97 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+// ======================
+// Destination interfaces
+// ======================
+#include "IDestination.hpp"
+// ====
+// JSON
+// ====
+#include "JSON_Destinations.hpp"
+#include "JSON_Writer.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_Generator {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // =====================
+  // JSON generator error
+  // =====================
+  struct Error : public std::runtime_error {
+    explicit Error(const std::string &message)
+        : std::runtime_error("JSON Generator Error: " + message) {}
+  };
+  // Document shapes
+  enum class Shape {
+    records, // Array of string heavy records (Twitter like)
+    numeric, // Array of coordinate rings (Canada like)
+    nested,  // Array of deeply nested configurations
+    escapes, // Array of escape and multi-byte character dense strings
+    wide     // Single object with very many members
+  };
+  static constexpr std::uint64_t kDefaultSeed{0x4A534F4E4C6962};
+  // Bytes generated before being passed on to the destination
+  static constexpr std::size_t kChunkSize{64 * 1024};
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  explicit JSON_Generator(Shape shape, std::uint64_t seed = kDefaultSeed);
+  JSON_Generator(const JSON_Generator &other) = delete;
+  JSON_Generator &operator=(const JSON_Generator &other) = delete;
+  JSON_Generator(JSON_Generator &&other) = delete;
+  JSON_Generator &operator=(JSON_Generator &&other) = delete;
+  ~JSON_Generator() = default;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  std::uint64_t generate(std::uint64_t size, IDestination &destination);
+  std::uint64_t generate(std::uint64_t size, IDestination &&destination);
+  std::string generate(std::uint64_t size);
+  static Shape shape(const std::string_view &name);
+  static std::string_view name(Shape shape);
+  static const std::vector<Shape> &shapes();
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  std::uint64_t next();
+  std::uint64_t uniform(std::uint64_t range);
+  double real(double low, double high);
+  std::string words(std::size_t count);
+  std::string escapes();
+  void addRecord(JSONWriter &writer);
+  void addCoordinates(JSONWriter &writer);
+  void addConfiguration(JSONWriter &writer, int depth);
+  void addEntry(JSONWriter &writer);
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  Shape m_shape;
+  // Pseudo random number generator state
+  std::uint64_t m_state;
+  // Number of entries generated
+  std::uint64_t m_entry{};
+  // Chunk being generated
+  BufferDestination m_chunk{kChunkSize};
+};
+} // namespace JSONLib
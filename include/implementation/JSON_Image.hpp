@@ -0,0 +1,168 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+// ======================
+// Destination interfaces
+// ======================
+#include "IDestination.hpp"
+// ====
+// JSON
+// ====
+#include "JSON_Types.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_Image {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // ===================
+  // JSON image error
+  // ===================
+  struct Error : public std::runtime_error {
+    explicit Error(const std::string &message)
+        : std::runtime_error("JSON Image Error: " + message) {}
+  };
+  // ==================================================================
+  // Image layout (all words 64 bit host byte order, 8 byte aligned):
+  //   header  : magic, byte order mark
+  //   nodes   : node blocks, children always before their parent
+  //   trailer : reference to root node
+  // A node reference holds its tag in the top byte and the offset of its
+  // block from the start of the image in the remainder; no pointers are
+  // stored so an image may be mapped at any address. Blocks are:
+  //   object  : count, count x (key offset, value reference),
+  //             count x entry index sorted by key
+  //   array   : count, count x value reference
+  //   string  : length, bytes (zero padded to 8 bytes)
+  //   integer : 64 bit signed value
+  //   double  : 64 bit IEEE 754 value
+  // Booleans and null have no block.
+  // ==================================================================
+  enum class Tag : char {
+    object = '{',
+    array = '[',
+    string = '"',
+    integer = 'l',
+    floatingPoint = 'd',
+    booleanTrue = 't',
+    booleanFalse = 'f',
+    null = 'n'
+  };
+  static constexpr std::string_view kMagic{"JNI1\0\0\0\0", 8};
+  static constexpr std::uint64_t kByteOrderMark{0x0102030405060708};
+  static constexpr std::size_t kWordSize{sizeof(std::uint64_t)};
+  static constexpr std::size_t kHeaderSize{2 * kWordSize};
+  static constexpr int kTagShift{56};
+  static constexpr std::uint64_t kOffsetMask{(1ull << kTagShift) - 1};
+  // ========================================
+  // Read only JNode like view onto the image
+  // ========================================
+  class View {
+  public:
+    // Child iterator (in document order)
+    class Iterator {
+    public:
+      Iterator(const JSON_Image *image, std::uint64_t entry, bool object)
+          : m_image(image), m_entry(entry), m_object(object) {}
+      View operator*() const;
+      [[nodiscard]] std::string_view key() const;
+      Iterator &operator++();
+      bool operator==(const Iterator &other) const {
+        return (m_entry == other.m_entry);
+      }
+
+    private:
+      const JSON_Image *m_image;
+      std::uint64_t m_entry;
+      bool m_object;
+    };
+    View(const JSON_Image *image, std::uint64_t reference)
+        : m_image(image), m_reference(reference) {}
+    // Get node type
+    [[nodiscard]] JNodeType getNodeType() const;
+    // Number of entries in an object/array
+    [[nodiscard]] std::size_t size() const;
+    // Object/array indexing (object keys are found by binary search)
+    View operator[](const std::string_view &key) const;
+    View operator[](std::size_t index) const;
+    [[nodiscard]] bool contains(const std::string_view &key) const;
+    // Scalar values
+    [[nodiscard]] std::string_view string() const;
+    [[nodiscard]] bool isLLong() const { return (tag() == Tag::integer); }
+    [[nodiscard]] bool isDouble() const {
+      return (tag() == Tag::floatingPoint);
+    }
+    [[nodiscard]] long long getLLong() const;
+    [[nodiscard]] double getDouble() const;
+    [[nodiscard]] bool boolean() const;
+    // Iterate over children of an object/array
+    [[nodiscard]] Iterator begin() const;
+    [[nodiscard]] Iterator end() const;
+
+  private:
+    [[nodiscard]] Tag tag() const {
+      return (static_cast<Tag>(m_reference >> kTagShift));
+    }
+    [[nodiscard]] std::uint64_t offset() const {
+      return (m_reference & kOffsetMask);
+    }
+    [[nodiscard]] std::uint64_t find(const std::string_view &key) const;
+    const JSON_Image *m_image;
+    std::uint64_t m_reference;
+  };
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  JSON_Image(const JSON_Image &other) = delete;
+  JSON_Image &operator=(const JSON_Image &other) = delete;
+  JSON_Image(JSON_Image &&other) = delete;
+  JSON_Image &operator=(JSON_Image &&other) = delete;
+  ~JSON_Image();
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  static JSON_Image open(const std::string &fileName);
+  static JSON_Image fromMemory(const std::string_view &image);
+  static void write(const JNode &jNode, IDestination &destination);
+  static void write(const JNode &jNode, IDestination &&destination);
+  [[nodiscard]] View root() const;
+  [[nodiscard]] std::uint64_t word(std::uint64_t offset) const;
+  [[nodiscard]] std::string_view string(std::uint64_t offset) const;
+  [[nodiscard]] std::string_view image() const { return (m_image); }
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  // Use open()/fromMemory() (a string converts to a string_view so these
+  // two would be ambiguous to callers)
+  explicit JSON_Image(const std::string_view &image);
+  explicit JSON_Image(const std::string &fileName);
+  void checkImage() const;
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Image bytes (mapped, owned or supplied by the caller)
+  std::string_view m_image;
+  // Mapped file (if any)
+  void *m_mapping{nullptr};
+  // Image read into memory where mapping is not available
+  std::string m_buffer;
+};
+} // namespace JSONLib
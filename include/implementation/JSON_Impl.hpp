@@ -2,10 +2,17 @@
 // =======
 // C++ STL
 // =======
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <memory_resource>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 // =============================
 // Source/Destination interfaces
@@ -15,6 +22,8 @@
 // ====
 // JSON
 // ====
+#include "JSON.hpp"
+#include "JSON_ByteCountingResource.hpp"
 #include "JSON_Config.hpp"
 #include "JSON_Converter.hpp"
 #include "JSON_Sources.hpp"
@@ -40,17 +49,28 @@ public:
   JSON_Impl &operator=(const JSON_Impl &other) = delete;
   JSON_Impl(JSON_Impl &&other) = delete;
   JSON_Impl &operator=(JSON_Impl &&other) = delete;
-  ~JSON_Impl() = default;
+  ~JSON_Impl();
   // ==============
   // PUBLIC METHODS
   // ==============
   std::string version();
   void parse(ISource &source);
+  JSON::ValidationResult validate(ISource &source);
   void parse(const std::string &jsonString);
   void stringify(IDestination &destination);
+  void stringifyParallel(IDestination &destination);
+  void parseBinary(ISource &source);
+  void stringifyBinary(IDestination &destination);
   void strip(ISource &source, IDestination &destination);
   void translator(ITranslator *translator);
   void converter(IConverter *converter);
+  void resource(std::pmr::memory_resource *resource);
+  void resource(std::unique_ptr<std::pmr::memory_resource> resource);
+  void arena();
+  void deferDestruction(bool deferDestruction);
+  [[nodiscard]] JSON::Statistics stats() const;
+  void resetStats();
+  [[nodiscard]] JSON::MemoryUsage memoryUsage() const;
   [[nodiscard]] JNode &root() { return (*m_jNodeRoot); }
   [[nodiscard]] const JNode &root() const { return (*m_jNodeRoot); }
   JNode &operator[](const std::string &key);
@@ -64,28 +84,111 @@ private:
   // ===========================
   // PRIVATE TYPES AND CONSTANTS
   // ===========================
+  // Minimum root entries before stringification is split between threads
+  static constexpr std::size_t kMinParallelEntries{1024};
+  // Number of ranges per thread (allows load balancing by stealing)
+  static constexpr std::size_t kRangesPerThread{4};
+  // ==true then statistics are gathered (compile time switch)
+  static constexpr bool kStatistics{JSON_STATISTICS != 0};
+  // Statistics counter that may be updated by several threads at once
+  using SharedCounter = std::atomic<std::uint64_t>;
+  // Add time (in nanoseconds) from construction to destruction to a
+  // statistics timer
+  class PhaseTimer {
+  public:
+    explicit PhaseTimer(SharedCounter &time) : m_time(time) {
+      if constexpr (kStatistics) {
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+    PhaseTimer(const PhaseTimer &other) = delete;
+    PhaseTimer &operator=(const PhaseTimer &other) = delete;
+    ~PhaseTimer() {
+      if constexpr (kStatistics) {
+        m_time.fetch_add(
+            static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - m_start)
+                    .count()),
+            std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    SharedCounter &m_time;
+    std::chrono::steady_clock::time_point m_start;
+  };
   // ===============
   // PRIVATE METHODS
   // ===============
-  static std::string extractString(ISource &source, bool translate = true);
-  static JNodeObject::ObjectEntry parseKeyValuePair(ISource &source);
-  static JNode::Ptr parseString(ISource &source);
-  static JNode::Ptr parseNumber(ISource &source);
-  static JNode::Ptr parseBoolean(ISource &source);
-  static JNode::Ptr parseNull(ISource &source);
-  static JNode::Ptr parseObject(ISource &source);
-  static JNode::Ptr parseArray(ISource &source);
-  static JNode::Ptr parseJNodes(ISource &source);
-  static void stringifyJNodes(const JNode &jNode, IDestination &destination);
-  static void stripWhiteSpace(ISource &source, IDestination &destination);
+  std::string_view extractString(ISource &source, bool translate = true);
+  JNodeObject::ObjectEntry parseKeyValuePair(ISource &source);
+  JNode::Ptr parseString(ISource &source);
+  JNodeNumeric extractNumber(ISource &source);
+  JNode::Ptr parseNumber(ISource &source);
+  JNode::Ptr parseNumericArray(ISource &source, JNodeArray::ArrayList &array,
+                               bool &expectElement);
+  JNode::Ptr parseBoolean(ISource &source);
+  JNode::Ptr parseNull(ISource &source);
+  JNode::Ptr parseObject(ISource &source);
+  JNode::Ptr parseArray(ISource &source);
+  JNode::Ptr parseJNodes(ISource &source);
+  void validateString(ISource &source);
+  void validateNumber(ISource &source);
+  void validateObject(ISource &source);
+  void validateArray(ISource &source);
+  void validateJNodes(ISource &source);
+  static std::size_t estimateJNodes(const JNode &jNode);
+  static void measureJNodes(const JNode &jNode, JSON::MemoryUsage &usage);
+  void stringifyJNodes(const JNode &jNode, IDestination &destination);
+  void stringifyKey(const std::pmr::string &key, IDestination &destination);
+  void stringifyString(const std::string_view &string,
+                       IDestination &destination);
+  void stripWhiteSpace(ISource &source, IDestination &destination);
+  [[nodiscard]] bool deferrable() const;
+  void replaceRoot(JNode::Ptr jNodeRoot);
+  template <typename Build> void buildRoot(Build build);
   // =================
   // PRIVATE VARIABLES
   // =================
+  // Counts what an owned arena takes from upstream (declared before the
+  // owned resource so that it outlives the arena)
+  std::unique_ptr<ByteCountingResource> m_arenaCounting;
+  // Memory resource owned by (and released with) this object if any
+  std::unique_ptr<std::pmr::memory_resource> m_ownedResource;
+  // Memory resource used to allocate JNode tree
+  std::pmr::memory_resource *m_resource{std::pmr::get_default_resource()};
+  // ==true then the owned resource is an arena replaced on each parse
+  bool m_arena{false};
+  // ==true then old JNode trees destroyed on reclaimer thread
+  bool m_deferDestruction{false};
   // Root of JSON tree
-  std::unique_ptr<JNode> m_jNodeRoot;
+  JNode::Ptr m_jNodeRoot;
+  // Pointer to character conversion interface (declared before translator
+  // as the default translator holds a reference to it)
+  std::unique_ptr<IConverter> m_converter;
   // Pointer to JSON translator interface
-  inline static std::unique_ptr<ITranslator> m_translator;
-  // Pointer to character conversion interface
-  inline static std::unique_ptr<IConverter> m_converter;
+  std::unique_ptr<ITranslator> m_translator;
+  // ==true then default converter/translator in use so strings can be
+  // escaped directly into the destination
+  bool m_defaultConverter{true};
+  bool m_escapeDirect{true};
+  // Scratch buffer used while extracting strings/numbers
+  std::string m_stringScratch;
+  // Scratch buffers used while parsing a run of numbers in an array
+  std::vector<JNodeNumeric> m_numericScratch;
+  std::vector<std::int64_t> m_integerScratch;
+  std::vector<double> m_floatingPointScratch;
+  std::vector<float> m_floatScratch;
+  // Parse statistics and current parse nesting depth
+  JSON::Statistics m_statistics{kStatistics};
+  std::uint64_t m_depth{};
+  // Statistics also updated by operations that leave the JNode tree alone
+  // (so may be run on a shared const JSON from several threads at once)
+  SharedCounter m_bytesConsumed{};
+  SharedCounter m_parseTime{};
+  SharedCounter m_stringifyTime{};
+  SharedCounter m_stripTime{};
+  SharedCounter m_validateTime{};
 };
 } // namespace JSONLib
@@ -3,6 +3,7 @@
 // C++ STL
 // =======
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <variant>
@@ -10,47 +11,44 @@
 // NAMESPACE
 // =========
 namespace JSONLib {
-// ===========
-// JNode Types
-// ===========
-enum class JNodeType {
-  base = 0,
-  object,
-  array,
-  number,
-  string,
-  boolean,
-  null,
-  hole
-};
 // =====
 // JNode
 // =====
-struct JNodeVariant;
 struct JNode {
   // Pointer to JNode
-  using Ptr = std::unique_ptr<JNode>;
+  using Ptr = std::unique_ptr<JNode, JNodeDeleter>;
   // Possible JSON node value types
   using InternalTypes =
       std::variant<int, long, long long, float, double, long double, bool,
                    std::string, std::nullptr_t>;
+  // Node storage; the type tag and payload are held inline within the
+  // JNode itself so that creating a node requires a single allocation.
+  // Alternatives are ordered to match JNodeType (less base).
+  using Variants = std::variant<JNodeObject, JNodeArray, JNodeNumber,
+                                JNodeString, JNodeBoolean, JNodeNull, JNodeHole>;
   // JNode Error
   struct Error : public std::runtime_error {
     explicit Error(const std::string &message)
         : std::runtime_error("JNode Error: " + message) {}
   };
   // Constructors/Destructors
-  explicit JNode(std::unique_ptr<JNodeVariant> jNodeVariant)
-      : m_jNodeVariant(std::move(jNodeVariant)) {}
-  JNode(const std::initializer_list<InternalTypes> &list);
+  template <typename T>
+  requires std::is_base_of_v<JNodeVariant, T>
+  explicit JNode(T &&jNodeVariant) : m_jNodeVariant(std::move(jNodeVariant)) {}
+  // Nodes built from an initializer list are allocated from the resource
+  // passed (the default resource if none); they keep it when moved into a
+  // tree so pass the tree's getMemoryResource() to keep it in one resource.
+  JNode(const std::initializer_list<InternalTypes> &list,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
   JNode(
-      const std::initializer_list<std::pair<std::string, InternalTypes>> &list);
+      const std::initializer_list<std::pair<std::string, InternalTypes>> &list,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
   JNode(const JNode &other) = delete;
   JNode &operator=(const JNode &other) = delete;
   JNode(JNode &&other) = default;
   JNode &operator=(JNode &&other) = default;
-  ~JNode() = default;
-  // Assignment operators
+  ~JNode();
+  // Assignment operators (the node keeps its memory resource)
   JNode &operator=(float floatingPoint);
   JNode &operator=(double floatingPoint);
   JNode &operator=(long double floatingPoint);
@@ -67,12 +65,140 @@ struct JNode {
   JNode &operator[](std::size_t index);
   const JNode &operator[](std::size_t index) const;
   // Get JNode type
-  [[nodiscard]] JNodeType getNodeType() const;
+  [[nodiscard]] JNodeType getNodeType() const {
+    return (static_cast<JNodeType>(m_jNodeVariant.index() + 1));
+  }
+  // Get memory resource used by JNode for any allocations
+  [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const;
   // Get reference to JNodeVariant
-  [[nodiscard]] std::unique_ptr<JNodeVariant> &getJNodeVariant();
-  [[nodiscard]] const std::unique_ptr<JNodeVariant> &getJNodeVariant() const;
+  [[nodiscard]] JNodeVariant &getJNodeVariant() {
+    return (std::visit([](auto &variant) -> JNodeVariant & { return variant; },
+                       m_jNodeVariant));
+  }
+  [[nodiscard]] const JNodeVariant &getJNodeVariant() const {
+    return (std::visit(
+        [](const auto &variant) -> const JNodeVariant & { return variant; },
+        m_jNodeVariant));
+  }
 
 private:
-  std::unique_ptr<JNodeVariant> m_jNodeVariant;
+  Variants m_jNodeVariant;
 };
-} // namespace JSONLib
\ No newline at end of file
+// ============================================
+// JNode variant methods needing complete JNode
+// ============================================
+// =======
+// Deleter
+// =======
+inline void JNodeDeleter::operator()(JNode *jNode) const {
+  jNode->~JNode();
+  resource->deallocate(jNode, sizeof(JNode), alignof(JNode));
+}
+// ======
+// Object
+// ======
+inline JNodeObject::ObjectList::const_iterator
+JNodeObject::findKey(const std::string_view &key, const ObjectList &objects) {
+  auto entry = std::find_if(
+      objects.begin(), objects.end(),
+      [&key](const JNodeObject::ObjectEntry &entry) -> bool {
+        return (entry.key == key);
+      });
+  if (entry == objects.end()) {
+    throw JNode::Error("Invalid key used to access object.");
+  }
+  return (entry);
+}
+inline bool JNodeObject::contains(const std::string_view &key) const {
+  try {
+    [[maybe_unused]] auto entry = findKey(key, m_jsonObjects);
+  } catch ([[maybe_unused]] const JNode::Error &e) {
+    return (false);
+  }
+  return (true);
+}
+inline JNode &JNodeObject::operator[](const std::string_view &key) {
+  return (*(findKey(key, m_jsonObjects)->value));
+}
+inline const JNode &
+JNodeObject::operator[](const std::string_view &key) const {
+  return (*(findKey(key, m_jsonObjects)->value));
+}
+// =====
+// Array
+// =====
+inline std::size_t JNodeArray::size() const {
+  return (m_packed != nullptr ? m_packed->size : m_jsonArray.size());
+}
+inline JNodeArray::Packing JNodeArray::packing() const {
+  return (m_packed != nullptr ? m_packed->packing : Packing::none);
+}
+inline std::span<const std::int64_t> JNodeArray::integers() const {
+  if (packing() != Packing::integer) {
+    return {};
+  }
+  return {reinterpret_cast<const std::int64_t *>(m_packed + 1), m_packed->size};
+}
+inline std::span<const double> JNodeArray::floatingPoints() const {
+  if (packing() != Packing::floatingPoint) {
+    return {};
+  }
+  return {reinterpret_cast<const double *>(m_packed + 1), m_packed->size};
+}
+inline std::span<const float> JNodeArray::floatingPoints32() const {
+  if (packing() != Packing::floatingPoint32) {
+    return {};
+  }
+  return {reinterpret_cast<const float *>(m_packed + 1), m_packed->size};
+}
+inline JNode &JNodeArray::operator[](std::size_t index) {
+  if (index < size()) {
+    return (*array()[index]);
+  }
+  throw JNode::Error("Invalid index used to access array.");
+}
+inline const JNode &JNodeArray::operator[](std::size_t index) const {
+  if (index < size()) {
+    return (*array()[index]);
+  }
+  throw JNode::Error("Invalid index used to access array.");
+}
+// =========================
+// JNode reference converter
+// =========================
+template <typename T> void CheckJNodeType(const JNode &jNode) {
+  if constexpr (std::is_same_v<T, JNodeString>) {
+    if (jNode.getNodeType() != JNodeType::string) {
+      throw JNode::Error("Node not a string.");
+    }
+  } else if constexpr (std::is_same_v<T, JNodeNumber>) {
+    if (jNode.getNodeType() != JNodeType::number) {
+      throw JNode::Error("Node not a number.");
+    }
+  } else if constexpr (std::is_same_v<T, JNodeArray>) {
+    if (jNode.getNodeType() != JNodeType::array) {
+      throw JNode::Error("Node not an array.");
+    }
+  } else if constexpr (std::is_same_v<T, JNodeObject>) {
+    if (jNode.getNodeType() != JNodeType::object) {
+      throw JNode::Error("Node not an object.");
+    }
+  } else if constexpr (std::is_same_v<T, JNodeBoolean>) {
+    if (jNode.getNodeType() != JNodeType::boolean) {
+      throw JNode::Error("Node not an boolean.");
+    }
+  } else if constexpr (std::is_same_v<T, JNodeNull>) {
+    if (jNode.getNodeType() != JNodeType::null) {
+      throw JNode::Error("Node not a null.");
+    }
+  }
+}
+template <typename T> T &JNodeRef(JNode &jNode) {
+  CheckJNodeType<T>(jNode);
+  return (static_cast<T &>(jNode.getJNodeVariant()));
+}
+template <typename T> const T &JNodeRef(const JNode &jNode) {
+  CheckJNodeType<T>(jNode);
+  return (static_cast<const T &>(jNode.getJNodeVariant()));
+}
+} // namespace JSONLib
@@ -3,6 +3,8 @@
 // C++ STL
 // =======
 #include <memory>
+#include <memory_resource>
+#include <string_view>
 // =========
 // NAMESPACE
 // =========
@@ -10,32 +12,43 @@ namespace JSONLib {
 // ==============
 // JNode Creation
 // ==============
-inline std::unique_ptr<JNode> makeObject(JNodeObject::ObjectList &objects) {
-  return (std::make_unique<JNode>(
-      JNode{std::make_unique<JNodeObject>(JNodeObject{objects})}));
+template <typename T>
+JNode::Ptr makeJNode(T &&jNodeVariant, std::pmr::memory_resource *resource) {
+  void *memory = resource->allocate(sizeof(JNode), alignof(JNode));
+  return (JNode::Ptr{new (memory) JNode{std::forward<T>(jNodeVariant)},
+                     JNodeDeleter{resource}});
 }
-inline std::unique_ptr<JNode> makeArray(JNodeArray::ArrayList &array) {
-  return (std::make_unique<JNode>(
-      JNode{std::make_unique<JNodeArray>(JNodeArray{array})}));
+inline JNode::Ptr makeObject(
+    JNodeObject::ObjectList &objects,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeObject{objects}, resource));
 }
-inline std::unique_ptr<JNode> makeNumber(const JNodeNumeric &number) {
-  return (std::make_unique<JNode>(
-      JNode{std::make_unique<JNodeNumber>(JNodeNumber{number})}));
+inline JNode::Ptr makeArray(
+    JNodeArray::ArrayList &array,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeArray{array}, resource));
 }
-inline std::unique_ptr<JNode> makeString(const std::string &string) {
-  return (std::make_unique<JNode>(
-      JNode{std::make_unique<JNodeString>(JNodeString{string})}));
+inline JNode::Ptr makeNumber(
+    const JNodeNumeric &number,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeNumber{number, resource}, resource));
 }
-inline std::unique_ptr<JNode> makeBoolean(bool boolean) {
-  return (std::make_unique<JNode>(
-      JNode{std::make_unique<JNodeBoolean>(JNodeBoolean{boolean})}));
+inline JNode::Ptr makeString(
+    const std::string_view &string,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeString{string, resource}, resource));
 }
-inline std::unique_ptr<JNode> makeNull() {
-  return (
-      std::make_unique<JNode>(JNode{std::make_unique<JNodeNull>(JNodeNull())}));
+inline JNode::Ptr makeBoolean(
+    bool boolean,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeBoolean{boolean, resource}, resource));
 }
-inline std::unique_ptr<JNode> makeHole() {
-  return (
-      std::make_unique<JNode>(JNode{std::make_unique<JNodeHole>(JNodeHole())}));
+inline JNode::Ptr makeNull(
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeNull{resource}, resource));
 }
-}
\ No newline at end of file
+inline JNode::Ptr makeHole(
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+  return (makeJNode(JNodeHole{resource}, resource));
+}
+} // namespace JSONLib
@@ -2,10 +2,17 @@
 // =======
 // C++ STL
 // =======
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory_resource>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 // =========
 // NAMESPACE
@@ -25,24 +32,32 @@ struct JNodeNumeric {
   // Shortened type names
   using llong = long long;
   using ldouble = long double;
-  // Number to string
-  template <Integer T> std::string numericToString(const T &t) const {
-    std::ostringstream os;
-    os << t;
-    return os.str();
-  }
-  template <Float T> std::string numericToString(const T &t) const {
-    std::ostringstream os;
-    os << t;
-    std::string floatString = os.str();
-    if (floatString.find(".") == std::string::npos) {
-      floatString.push_back('.');
-    }
-    floatString.erase(floatString.find_last_not_of('0') + 1, std::string::npos);
-    if (floatString.back() == '.') {
-      floatString += '0';
+  // Buffer size large enough to hold any formatted number
+  static constexpr std::size_t kMaxCharacters{64};
+  // Number to characters (floating point uses the shortest representation
+  // that round trips and is locale independent).
+  template <Integer T>
+  static char *numericToChars(char *first, char *last, const T &t) {
+    return (std::to_chars(first, last, t).ptr);
+  }
+  template <Float T>
+  static char *numericToChars(char *first, char *last, const T &t) {
+    char *end = std::to_chars(first, last, t).ptr;
+    // Keep a decimal point so value is read back as floating point
+    if (std::none_of(first, end, [](char ch) {
+          return (ch == '.' || ch == 'e' || ch == 'n' || ch == 'i');
+        })) {
+      *end++ = '.';
+      *end++ = '0';
     }
-    return floatString;
+    return (end);
+  }
+  // Number to string
+  template <typename T> std::string numericToString(const T &t) const {
+    std::array<char, kMaxCharacters> buffer;
+    return (std::string{buffer.data(),
+                        numericToChars(buffer.data(),
+                                       buffer.data() + buffer.size(), t)});
   }
   // JNodeNumeric Error
   struct Error : public std::runtime_error {
@@ -51,31 +66,40 @@ struct JNodeNumeric {
   };
   // Convert types
   template <typename T> T convertType() const {
-    if (m_type == Type::Int) {
+    if (type() == Type::Int) {
       return (static_cast<T>(m_values.m_integer));
-    } else if (m_type == Type::Long) {
+    } else if (type() == Type::Long) {
       return (static_cast<T>(m_values.m_long));
-    } else if (m_type == Type::LLong) {
+    } else if (type() == Type::LLong) {
       return (static_cast<T>(m_values.m_llong));
-    } else if (m_type == Type::Float) {
+    } else if (type() == Type::Float) {
       return (static_cast<T>(m_values.m_float));
-    } else if (m_type == Type::Double) {
-      return (static_cast<T>(m_values.m_double));
-    } else if (m_type == Type::LDouble) {
+    } else if (type() == Type::Double) {
       return (static_cast<T>(m_values.m_double));
+    } else if (type() == Type::LDouble) {
+      return (static_cast<T>(*m_values.m_ldouble));
     }
     throw Error("Could not convert unknown type.");
   }
-  // Number type
-  enum class Type { Int = 0, Long, LLong, Float, Double, LDouble };
-  // Numeric union
+  // Number type (held in the low bits of the tag word)
+  enum class Type : std::uint8_t {
+    Int = 0,
+    Long,
+    LLong,
+    Float,
+    Double,
+    LDouble
+  };
+  // Numeric union; kept to 8 bytes so that number nodes stay small. A long
+  // double (16 bytes on most platforms) is rare in JSON so is held out of
+  // line, allocated from the memory resource held in the tag word.
   union Numbers {
     int m_integer;
     long m_long;
     llong m_llong;
     float m_float;
     double m_double;
-    ldouble m_ldouble;
+    ldouble *m_ldouble;
   };
   // Constructors/Destructors
   JNodeNumeric() = default;
@@ -84,33 +108,60 @@ struct JNodeNumeric {
   }
   explicit JNodeNumeric(int integer) {
     m_values.m_integer = integer;
-    m_type = Type::Int;
+    type(Type::Int);
   }
   explicit JNodeNumeric(long integer) {
     m_values.m_long = integer;
-    m_type = Type::Long;
+    type(Type::Long);
   }
   explicit JNodeNumeric(llong integer) {
     m_values.m_llong = integer;
-    m_type = Type::LLong;
+    type(Type::LLong);
   }
   explicit JNodeNumeric(float floatingPoint) {
     m_values.m_float = floatingPoint;
-    m_type = Type::Float;
+    type(Type::Float);
   }
   explicit JNodeNumeric(double floatingPoint) {
     m_values.m_double = floatingPoint;
-    m_type = Type::Double;
+    type(Type::Double);
   }
   explicit JNodeNumeric(ldouble floatingPoint) {
-    m_values.m_ldouble = floatingPoint;
-    m_type = Type::LDouble;
-  }
-  JNodeNumeric(const JNodeNumeric &other) = default;
-  JNodeNumeric &operator=(const JNodeNumeric &other) = default;
-  JNodeNumeric(JNodeNumeric &&other) = default;
-  JNodeNumeric &operator=(JNodeNumeric &&other) = default;
-  ~JNodeNumeric() = default;
+    [[maybe_unused]] auto set = setLDouble(floatingPoint);
+  }
+  // Copy a numeric allocating any out of line value from a memory resource
+  JNodeNumeric(const JNodeNumeric &other, std::pmr::memory_resource *resource)
+      : m_tag(reinterpret_cast<std::uintptr_t>(resource)) {
+    assign(other);
+  }
+  JNodeNumeric(const JNodeNumeric &other) { assign(other); }
+  JNodeNumeric &operator=(const JNodeNumeric &other) {
+    if (this != &other) {
+      assign(other);
+    }
+    return (*this);
+  }
+  JNodeNumeric(JNodeNumeric &&other) noexcept
+      : m_values(other.m_values), m_tag(other.m_tag) {
+    other.type(Type::Int);
+  }
+  // An out of line value is only taken over if it was allocated from the
+  // same memory resource (otherwise it is copied into this one)
+  JNodeNumeric &operator=(JNodeNumeric &&other) {
+    if (this != &other) {
+      if (other.isLDouble() && tagResource() != nullptr &&
+          tagResource() != other.tagResource()) {
+        assign(other);
+      } else {
+        release();
+        m_values = other.m_values;
+        m_tag = other.m_tag;
+        other.type(Type::Int);
+      }
+    }
+    return (*this);
+  }
+  ~JNodeNumeric() { release(); }
   // Is character a valid numeric character ?
   // Includes possible sign, decimal point or exponent
   [[nodiscard]] static bool isValidNumericChar(char ch) {
@@ -118,12 +169,12 @@ struct JNodeNumeric {
             ch == 'E' || ch == 'e');
   }
   // Is number a int/long/llong/float/double/ldouble ?
-  [[nodiscard]] bool isInt() const { return (m_type == Type::Int); }
-  [[nodiscard]] bool isLong() const { return (m_type == Type::Long); }
-  [[nodiscard]] bool isLLong() const { return (m_type == Type::LLong); }
-  [[nodiscard]] bool isFloat() const { return (m_type == Type::Float); }
-  [[nodiscard]] bool isDouble() const { return (m_type == Type::Double); }
-  [[nodiscard]] bool isLDouble() const { return (m_type == Type::LDouble); }
+  [[nodiscard]] bool isInt() const { return (type() == Type::Int); }
+  [[nodiscard]] bool isLong() const { return (type() == Type::Long); }
+  [[nodiscard]] bool isLLong() const { return (type() == Type::LLong); }
+  [[nodiscard]] bool isFloat() const { return (type() == Type::Float); }
+  [[nodiscard]] bool isDouble() const { return (type() == Type::Double); }
+  [[nodiscard]] bool isLDouble() const { return (type() == Type::LDouble); }
   // Return numbers value int/long/llong/float/double/ldouble.
   // Note: Can still return a long value for floating point.
   [[nodiscard]] int getInt() const { return (convertType<int>()); }
@@ -135,111 +186,128 @@ struct JNodeNumeric {
   // Set numbers value to int/long/llong/float/double/ldouble
   // returning true if the value is set.
   [[nodiscard]] bool setInt(const std::string &number) {
+    int value;
     try {
       std::size_t end;
-      m_values.m_integer = std::stoi(number.c_str(), &end, 10);
+      value = std::stoi(number.c_str(), &end, 10);
       if (end != number.size()) {
         return (false);
       }
     } catch ([[maybe_unused]] const std::exception &e) {
       return (false);
     }
-    m_type = Type::Int;
-    return (true);
+    return (setInt(value));
   }
   [[nodiscard]] bool setInt(int number) {
-    m_type = Type::Int;
+    release();
+    type(Type::Int);
     m_values.m_integer = number;
     return (true);
   }
   [[nodiscard]] bool setLong(const std::string &number) {
+    long value;
     try {
       char *end;
-      m_values.m_long = std::strtol(number.c_str(), &end, 10);
+      value = std::strtol(number.c_str(), &end, 10);
       if (*end != '\0') {
         return (false);
       }
     } catch ([[maybe_unused]] const std::exception &e) {
       return (false);
     }
-    m_type = Type::Long;
-    return (true);
+    return (setLong(value));
   }
   [[nodiscard]] bool setLong(long number) {
-    m_type = Type::Long;
+    release();
+    type(Type::Long);
     m_values.m_long = number;
     return (true);
   }
   [[nodiscard]] bool setLLong(const std::string &number) {
+    llong value;
     try {
       char *end;
-      m_values.m_llong = std::strtoll(number.c_str(), &end, 10);
+      value = std::strtoll(number.c_str(), &end, 10);
       if (*end != '\0') {
         return (false);
       }
     } catch ([[maybe_unused]] const std::exception &e) {
       return (false);
     }
-    m_type = Type::LLong;
-    return (true);
+    return (setLLong(value));
   }
   [[nodiscard]] bool setLLong(llong number) {
-    m_type = Type::LLong;
+    release();
+    type(Type::LLong);
     m_values.m_llong = number;
     return (true);
   }
   [[nodiscard]] bool setFloat(const std::string &number) {
+    float value;
     try {
       std::size_t end;
-      m_values.m_float = std::stof(number.c_str(), &end);
+      value = std::stof(number.c_str(), &end);
       if (end != number.size()) {
         return (false);
       }
     } catch ([[maybe_unused]] const std::exception &e) {
       return (false);
     }
-    m_type = Type::Float;
-    return (true);
+    return (setFloat(value));
   }
   [[nodiscard]] bool setFloat(float number) {
-    m_type = Type::Float;
+    release();
+    type(Type::Float);
     m_values.m_float = number;
     return (true);
   }
   [[nodiscard]] bool setDouble(const std::string &number) {
+    double value;
     try {
       char *end;
-      m_values.m_double = std::strtod(number.c_str(), &end);
+      value = std::strtod(number.c_str(), &end);
       if (*end != '\0') {
         return (false);
       }
     } catch ([[maybe_unused]] const std::exception &e) {
       return (false);
     }
-    m_type = Type::Double;
-    return (true);
+    return (setDouble(value));
   }
   [[nodiscard]] bool setDouble(double number) {
-    m_type = Type::Double;
+    release();
+    type(Type::Double);
     m_values.m_double = number;
     return (true);
   }
   [[nodiscard]] bool setLDouble(const std::string &number) {
+    ldouble value;
     try {
       char *end;
-      m_values.m_ldouble = std::strtold(number.c_str(), &end);
+      value = std::strtold(number.c_str(), &end);
       if (*end != '\0') {
         return (false);
       }
     } catch ([[maybe_unused]] const std::exception &e) {
       return (false);
     }
-    m_type = Type::LDouble;
-    return (true);
+    return (setLDouble(value));
   }
   [[nodiscard]] bool setLDouble(ldouble number) {
-    m_type = Type::LDouble;
-    m_values.m_ldouble = number;
+    if (type() == Type::LDouble) {
+      *m_values.m_ldouble = number;
+    } else {
+      // Bind to the default resource so the value is freed to where it
+      // came from even if the default changes
+      if (tagResource() == nullptr) {
+        m_tag |= reinterpret_cast<std::uintptr_t>(
+            std::pmr::get_default_resource());
+      }
+      m_values.m_ldouble = static_cast<ldouble *>(
+          tagResource()->allocate(sizeof(ldouble), alignof(ldouble)));
+      *m_values.m_ldouble = number;
+      type(Type::LDouble);
+    }
     return (true);
   }
   // Set numeric value
@@ -247,9 +315,68 @@ struct JNodeNumeric {
     return (setInt(number) || setLong(number) || setLLong(number) ||
             setFloat(number) || setDouble(number) || setLDouble(number));
   }
+  // Format numeric into a character buffer (at least maxCharacters() long)
+  // returning the end of the characters written.
+  char *toChars(char *first, char *last) const {
+    switch (type()) {
+    case Type::Int:
+      return (numericToChars(first, last, m_values.m_integer));
+    case Type::Long:
+      return (numericToChars(first, last, m_values.m_long));
+    case Type::LLong:
+      return (numericToChars(first, last, m_values.m_llong));
+    case Type::Float:
+      return (numericToChars(first, last, m_values.m_float));
+    case Type::Double:
+      return (numericToChars(first, last, m_values.m_double));
+    case Type::LDouble:
+      return (numericToChars(first, last, *m_values.m_ldouble));
+    }
+    throw Error("Could not convert unknown type.");
+  }
+  // Upper bound on the number of characters numericToChars() writes for a
+  // value (exact for integers; floating point values of at least one but
+  // short of an integer part too long for their digits fit fixed notation)
+  template <Integer T> static std::size_t maxCharacters(T t) {
+    using Unsigned = std::make_unsigned_t<T>;
+    std::size_t characters{t < 0 ? 2U : 1U};
+    Unsigned magnitude = t < 0 ? Unsigned{} - static_cast<Unsigned>(t)
+                               : static_cast<Unsigned>(t);
+    for (; magnitude >= 10; magnitude /= 10) {
+      characters++;
+    }
+    return (characters);
+  }
+  static std::size_t maxCharacters(float t) {
+    return (std::fabs(t) >= 1.0f && std::fabs(t) < 1e8f ? 11 : 16);
+  }
+  static std::size_t maxCharacters(double t) {
+    return (std::fabs(t) >= 1.0 && std::fabs(t) < 1e16 ? 19 : 26);
+  }
+  static std::size_t maxCharacters([[maybe_unused]] long double t) {
+    return (32);
+  }
+  // Upper bound on the number of characters toChars() writes
+  [[nodiscard]] std::size_t maxCharacters() const {
+    switch (type()) {
+    case Type::Int:
+      return (maxCharacters(m_values.m_integer));
+    case Type::Long:
+      return (maxCharacters(m_values.m_long));
+    case Type::LLong:
+      return (maxCharacters(m_values.m_llong));
+    case Type::Float:
+      return (maxCharacters(m_values.m_float));
+    case Type::Double:
+      return (maxCharacters(m_values.m_double));
+    case Type::LDouble:
+      return (maxCharacters(*m_values.m_ldouble));
+    }
+    return (kMaxCharacters);
+  }
   // Get string representation of numeric
   [[nodiscard]] std::string getString() const {
-    switch (m_type) {
+    switch (type()) {
     case Type::Int:
       return (numericToString(m_values.m_integer));
     case Type::Long:
@@ -261,13 +388,54 @@ struct JNodeNumeric {
     case Type::Double:
       return (numericToString(m_values.m_double));
     case Type::LDouble:
-      return (numericToString(m_values.m_ldouble));
+      return (numericToString(*m_values.m_ldouble));
     }
     throw Error("Could not convert unknown type.");
   }
+  // Bytes allocated to hold the value out of line (if any)
+  [[nodiscard]] std::size_t allocatedBytes() const {
+    return (type() == Type::LDouble ? sizeof(ldouble) : 0);
+  }
+  // Memory resource any out of line value is allocated from
+  [[nodiscard]] std::pmr::memory_resource *resource() const {
+    return (tagResource() != nullptr ? tagResource()
+                                     : std::pmr::get_default_resource());
+  }
 
 private:
-  Type m_type;
-  Numbers m_values;
+  // Tag word low bits hold the number type; the rest is the memory resource
+  // pointer (resources are more than kTypeMask aligned) or zero if none has
+  // been set or used yet
+  static constexpr std::uintptr_t kTypeMask{0x7};
+  static_assert(alignof(std::pmr::memory_resource) > kTypeMask);
+  [[nodiscard]] Type type() const {
+    return (static_cast<Type>(m_tag & kTypeMask));
+  }
+  void type(Type type) {
+    m_tag = (m_tag & ~kTypeMask) | static_cast<std::uintptr_t>(type);
+  }
+  [[nodiscard]] std::pmr::memory_resource *tagResource() const {
+    return (reinterpret_cast<std::pmr::memory_resource *>(m_tag & ~kTypeMask));
+  }
+  // Set value to that of another numeric
+  void assign(const JNodeNumeric &other) {
+    if (other.type() == Type::LDouble) {
+      [[maybe_unused]] auto set = setLDouble(*other.m_values.m_ldouble);
+    } else {
+      release();
+      m_values = other.m_values;
+      type(other.type());
+    }
+  }
+  // Free any out of line value
+  void release() {
+    if (type() == Type::LDouble) {
+      tagResource()->deallocate(m_values.m_ldouble, sizeof(ldouble),
+                                alignof(ldouble));
+      type(Type::Int);
+    }
+  }
+  Numbers m_values{};
+  std::uintptr_t m_tag{static_cast<std::uintptr_t>(Type::Int)};
 };
 } // namespace JSONLib
\ No newline at end of file
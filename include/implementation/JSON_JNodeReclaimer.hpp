@@ -0,0 +1,64 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+// ====
+// JSON
+// ====
+#include "JSON_Types.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JNodeReclaimer {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  JNodeReclaimer();
+  JNodeReclaimer(const JNodeReclaimer &other) = delete;
+  JNodeReclaimer &operator=(const JNodeReclaimer &other) = delete;
+  JNodeReclaimer(JNodeReclaimer &&other) = delete;
+  JNodeReclaimer &operator=(JNodeReclaimer &&other) = delete;
+  ~JNodeReclaimer();
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  static JNodeReclaimer &instance();
+  void reclaim(JNode::Ptr jNodeRoot);
+  void flush();
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  void reclaimer();
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // JNode trees waiting to be destroyed
+  std::vector<JNode::Ptr> m_pending;
+  // Number of trees currently being destroyed
+  std::size_t m_inProgress{};
+  // Set to stop reclaimer thread
+  bool m_stop{};
+  std::mutex m_mutex;
+  std::condition_variable m_pendingChanged;
+  std::thread m_thread;
+};
+} // namespace JSONLib
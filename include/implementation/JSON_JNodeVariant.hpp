@@ -2,30 +2,60 @@
 // =======
 // C++ STL
 // =======
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 // =========
 // NAMESPACE
 // =========
 namespace JSONLib {
+// ===========
+// JNode Types
+// ===========
+enum class JNodeType {
+  base = 0,
+  object,
+  array,
+  number,
+  string,
+  boolean,
+  null,
+  hole
+};
+// ==========================================================
+// JNode (variants are held inline so only forward declared)
+// ==========================================================
+struct JNode;
+// ============================================================
+// JNode deleter; nodes are allocated from (and returned to) a
+// polymorphic memory resource.
+// ============================================================
+struct JNodeDeleter {
+  std::pmr::memory_resource *resource{std::pmr::get_default_resource()};
+  void operator()(JNode *jNode) const;
+};
 // ==============
 // JNode variants
 // ==============
 // ====
 // Base
 // ====
+// No type tag is held here (so the base takes no space in a variant); a
+// JNode's type is the index of the variant it holds and each variant
+// returns its own type from a static getNodeType().
 struct JNodeVariant {
-  explicit JNodeVariant(JNodeType nodeType = JNodeType::base)
-      : m_nodeType(nodeType) {}
-  [[nodiscard]] JNodeType getNodeType() const { return (m_nodeType); }
+  JNodeVariant() = default;
   JNodeVariant(const JNodeVariant &other) = delete;
   JNodeVariant &operator=(const JNodeVariant &other) = delete;
   JNodeVariant(JNodeVariant &&other) = default;
   JNodeVariant &operator=(JNodeVariant &&other) = default;
   ~JNodeVariant() = default;
-
-private:
-  JNodeType m_nodeType;
 };
 
 // ======
@@ -34,56 +64,42 @@ private:
 struct JNodeObject : JNodeVariant {
   // Object entry
   struct ObjectEntry {
-    std::string key;
-    JNode::Ptr value;
+    std::pmr::string key;
+    std::unique_ptr<JNode, JNodeDeleter> value;
   };
   // Object entry list
-  using ObjectList = std::vector<JNodeObject::ObjectEntry>;
+  using ObjectList = std::pmr::vector<JNodeObject::ObjectEntry>;
   // Constructors/Destructors
-  JNodeObject() : JNodeVariant(JNodeType::object) {}
+  explicit JNodeObject(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_jsonObjects(resource) {}
   explicit JNodeObject(ObjectList &objects)
-      : JNodeVariant(JNodeType::object), m_jsonObjects(std::move(objects)) {}
+      : m_jsonObjects(std::move(objects)) {}
   JNodeObject(const JNodeObject &other) = delete;
   JNodeObject &operator=(const JNodeObject &other) = delete;
   JNodeObject(JNodeObject &&other) = default;
   JNodeObject &operator=(JNodeObject &&other) = default;
   ~JNodeObject() = default;
-  // Search for a given entry given a key and object list
-  static auto findKey(const std::string &key, const ObjectList &objects) {
-    auto entry =
-        std::find_if(objects.begin(), objects.end(),
-                     [&key](const JNodeObject::ObjectEntry &entry) -> bool {
-                       return (entry.key == key);
-                     });
-    if (entry == objects.end()) {
-      throw JNode::Error("Invalid key used to access object.");
-    }
-    return (entry);
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::object);
   }
+  // Search for a given entry given a key and object list
+  static ObjectList::const_iterator findKey(const std::string_view &key,
+                                            const ObjectList &objects);
   // Find a given object entry given its key
-  [[nodiscard]] auto find(const std::string &key) const {
+  [[nodiscard]] auto find(const std::string_view &key) const {
     return (findKey(key, m_jsonObjects));
   }
   // Return true if an object contains a given key
-  [[nodiscard]] bool contains(const std::string &key) const {
-    try {
-      [[maybe_unused]] auto entry = findKey(key, m_jsonObjects);
-    } catch ([[maybe_unused]] const JNode::Error &e) {
-      return (false);
-    }
-    return (true);
-  }
+  [[nodiscard]] bool contains(const std::string_view &key) const;
   // Return number of entries in an object
   [[nodiscard]] int size() const {
     return (static_cast<int>(m_jsonObjects.size()));
   }
   // Return object entry for a given key
-  JNode &operator[](const std::string &key) {
-    return (*(findKey(key, m_jsonObjects)->value));
-  }
-  const JNode &operator[](const std::string &key) const {
-    return (*(findKey(key, m_jsonObjects)->value));
-  }
+  JNode &operator[](const std::string_view &key);
+  const JNode &operator[](const std::string_view &key) const;
   // Return reference to base of object entries
   ObjectList &objects() { return (m_jsonObjects); }
   [[nodiscard]] const ObjectList &objects() const { return (m_jsonObjects); }
@@ -96,51 +112,100 @@ private:
 // =====
 struct JNodeArray : JNodeVariant {
   // Array entry list
-  using ArrayList = std::vector<JNode::Ptr>;
+  using ArrayList = std::pmr::vector<std::unique_ptr<JNode, JNodeDeleter>>;
+  // Element type of a packed array; a homogeneous numeric array may have
+  // its values held contiguously rather than as a JNode each. Floating
+  // point values are packed as parsed, floats (floatingPoint32) or doubles.
+  enum class Packing : std::uint8_t {
+    none = 0,
+    integer,
+    floatingPoint,
+    floatingPoint32
+  };
   // Constructors/Destructors
-  JNodeArray() : JNodeVariant(JNodeType::array) {}
+  explicit JNodeArray(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_jsonArray(resource) {}
   explicit JNodeArray(ArrayList &array)
-      : JNodeVariant(JNodeType::array), m_jsonArray(std::move(array)) {}
+      : m_jsonArray(std::move(array)) {}
+  JNodeArray(std::span<const std::int64_t> integers,
+             std::pmr::memory_resource *resource);
+  JNodeArray(std::span<const double> floatingPoints,
+             std::pmr::memory_resource *resource);
+  JNodeArray(std::span<const float> floatingPoints,
+             std::pmr::memory_resource *resource);
   JNodeArray(const JNodeArray &other) = delete;
   JNodeArray &operator=(const JNodeArray &other) = delete;
-  JNodeArray(JNodeArray &&other) = default;
-  JNodeArray &operator=(JNodeArray &&other) = default;
-  ~JNodeArray() = default;
-  // Return the size of array
-  [[nodiscard]] std::size_t size() const { return (m_jsonArray.size()); }
-  // Return reference to array base
-  ArrayList &array() { return (m_jsonArray); }
-  [[nodiscard]] const ArrayList &array() const { return (m_jsonArray); }
-  // Array indexing operators
-  JNode &operator[](std::size_t index) {
-    if ((index >= 0) && (index < (static_cast<int>(m_jsonArray.size())))) {
-      return (*m_jsonArray[index]);
-    }
-    throw JNode::Error("Invalid index used to access array.");
+  JNodeArray(JNodeArray &&other) noexcept
+      : m_jsonArray(std::move(other.m_jsonArray)),
+        m_packed(std::exchange(other.m_packed, nullptr)) {}
+  // Packed values are only taken over if they were allocated from the
+  // same memory resource (otherwise they are copied into this one)
+  JNodeArray &operator=(JNodeArray &&other);
+  ~JNodeArray() { release(); }
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::array);
   }
-  const JNode &operator[](std::size_t index) const {
-    if ((index >= 0) && (index < (static_cast<int>(m_jsonArray.size())))) {
-      return (*m_jsonArray[index]);
-    }
-    throw JNode::Error("Invalid index used to access array.");
+  // Return the size of array
+  [[nodiscard]] std::size_t size() const;
+  // Return packed element type and values (empty if not that packing)
+  [[nodiscard]] Packing packing() const;
+  [[nodiscard]] std::span<const std::int64_t> integers() const;
+  [[nodiscard]] std::span<const double> floatingPoints() const;
+  [[nodiscard]] std::span<const float> floatingPoints32() const;
+  // Return a packed array element as a numeric
+  [[nodiscard]] JNodeNumeric numeric(std::size_t index) const;
+  // Return bytes allocated for packed values
+  [[nodiscard]] std::size_t packedBytes() const;
+  // Return memory resource used for array entries
+  [[nodiscard]] std::pmr::memory_resource *resource() const {
+    return (m_jsonArray.get_allocator().resource());
   }
+  // Return reference to array base. A packed array is unpacked into JNodes
+  // first (so is no longer packed); const access does not allocate so
+  // throws for a packed array, whose values are read with numeric().
+  ArrayList &array();
+  [[nodiscard]] const ArrayList &array() const;
+  // Array indexing operators; as array(), indexing a packed array unpacks
+  // it into the tree's resource and const indexing of one throws
+  JNode &operator[](std::size_t index);
+  const JNode &operator[](std::size_t index) const;
 
 private:
+  // Packed values (header followed by the values in one allocation)
+  struct Packed {
+    Packing packing;
+    std::size_t size;
+  };
+  template <typename T>
+  void pack(std::span<const T> values, Packing packing);
+  void pack(const JNodeArray &other);
+  [[nodiscard]] ArrayList unpacked() const;
+  [[nodiscard]] std::size_t valueBytes() const;
+  void release();
   ArrayList m_jsonArray;
+  Packed *m_packed{};
 };
 // ======
 // Number
 // ======
 struct JNodeNumber : JNodeVariant {
   // Constructors/Destructors
-  JNodeNumber() : JNodeVariant(JNodeType::number) {}
-  explicit JNodeNumber(const JNodeNumeric &number)
-      : JNodeVariant(JNodeType::number), m_jsonNumber(number) {}
+  JNodeNumber() = default;
+  explicit JNodeNumber(
+      const JNodeNumeric &number,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_jsonNumber(number, resource) {}
   JNodeNumber(const JNodeNumber &other) = delete;
   JNodeNumber &operator=(const JNodeNumber &other) = delete;
   JNodeNumber(JNodeNumber &&other) = default;
   JNodeNumber &operator=(JNodeNumber &&other) = default;
   ~JNodeNumber() = default;
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::number);
+  }
   // Return reference to number string
   [[nodiscard]] JNodeNumeric &number() { return (m_jsonNumber); }
   [[nodiscard]] const JNodeNumeric &number() const { return (m_jsonNumber); }
@@ -148,6 +213,10 @@ struct JNodeNumber : JNodeVariant {
   [[nodiscard]] std::string toString() const {
     return (m_jsonNumber.getString());
   }
+  // Memory resource of the tree the number belongs to
+  [[nodiscard]] std::pmr::memory_resource *resource() const {
+    return (m_jsonNumber.resource());
+  }
 
 private:
   JNodeNumeric m_jsonNumber{};
@@ -157,111 +226,120 @@ private:
 // ======
 struct JNodeString : JNodeVariant {
   // Constructors/Destructors
-  JNodeString() : JNodeVariant(JNodeType::string) {}
-  explicit JNodeString(std::string string)
-      : JNodeVariant(JNodeType::string), m_jsonString(std::move(string)) {}
+  JNodeString() = default;
+  explicit JNodeString(
+      const std::string_view &string,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_jsonString(string, resource) {}
   JNodeString(const JNodeString &other) = delete;
   JNodeString &operator=(const JNodeString &other) = delete;
   JNodeString(JNodeString &&other) = default;
   JNodeString &operator=(JNodeString &&other) = default;
   ~JNodeString() = default;
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::string);
+  }
   // Return reference to string
-  std::string &string() { return (m_jsonString); }
-  [[nodiscard]] const std::string &string() const { return (m_jsonString); }
+  std::pmr::string &string() { return (m_jsonString); }
+  [[nodiscard]] const std::pmr::string &string() const {
+    return (m_jsonString);
+  }
   // Convert string representation to a string
-  [[nodiscard]] std::string toString() const { return (m_jsonString); }
+  [[nodiscard]] std::string toString() const {
+    return (std::string{m_jsonString});
+  }
 
 private:
-  std::string m_jsonString;
+  std::pmr::string m_jsonString;
 };
 // =======
 // Boolean
 // =======
 struct JNodeBoolean : JNodeVariant {
   // Constructors/Destructors
-  JNodeBoolean() : JNodeVariant(JNodeType::boolean) {}
-  explicit JNodeBoolean(bool boolean)
-      : JNodeVariant(JNodeType::boolean), m_jsonBoolean(boolean) {}
+  JNodeBoolean() = default;
+  explicit JNodeBoolean(
+      bool boolean,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_jsonBoolean(boolean), m_resource(resource) {}
   JNodeBoolean(const JNodeBoolean &other) = delete;
   JNodeBoolean &operator=(const JNodeBoolean &other) = delete;
   JNodeBoolean(JNodeBoolean &&other) = default;
   JNodeBoolean &operator=(JNodeBoolean &&other) = default;
   ~JNodeBoolean() = default;
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::boolean);
+  }
   // Return boolean value
   [[nodiscard]] bool boolean() const { return (m_jsonBoolean); }
   // Return string representation of boolean value
   [[nodiscard]] std::string toString() const {
     return (m_jsonBoolean ? "true" : "false");
   }
+  // Memory resource of the tree the boolean belongs to
+  [[nodiscard]] std::pmr::memory_resource *resource() const {
+    return (m_resource);
+  }
 
 private:
   bool m_jsonBoolean{};
+  std::pmr::memory_resource *m_resource{std::pmr::get_default_resource()};
 };
 // ====
 // Null
 // ====
 struct JNodeNull : JNodeVariant {
   // Constructors/Destructors
-  JNodeNull() : JNodeVariant(JNodeType::null) {}
+  explicit JNodeNull(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_resource(resource) {}
   JNodeNull(const JNodeNull &other) = delete;
   JNodeNull &operator=(const JNodeNull &other) = delete;
   JNodeNull(JNodeNull &&other) = default;
   JNodeNull &operator=(JNodeNull &&other) = default;
   ~JNodeNull() = default;
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::null);
+  }
   // Return null value
   [[nodiscard]] void *null() const { return (nullptr); }
   // Return string representation of null value
   [[nodiscard]] std::string toString() const { return ("null"); }
+  // Memory resource of the tree the null belongs to
+  [[nodiscard]] std::pmr::memory_resource *resource() const {
+    return (m_resource);
+  }
+
+private:
+  std::pmr::memory_resource *m_resource;
 };
 // ====
 // Hole
 // ====
 struct JNodeHole : JNodeVariant {
   // Constructors/Destructors
-  JNodeHole() : JNodeVariant(JNodeType::hole) {}
+  explicit JNodeHole(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : m_resource(resource) {}
   JNodeHole(const JNodeHole &other) = delete;
   JNodeHole &operator=(const JNodeHole &other) = delete;
   JNodeHole(JNodeHole &&other) = default;
   JNodeHole &operator=(JNodeHole &&other) = default;
   ~JNodeHole() = default;
+  // Node type (held by the JNode as its variant index)
+  [[nodiscard]] static constexpr JNodeType getNodeType() {
+    return (JNodeType::hole);
+  }
   [[nodiscard]] std::string toString() const { return ("null"); }
-};
-// =========================
-// JNode reference converter
-// =========================
-template <typename T> void CheckJNodeType(const JNodeVariant &jNodeVariant) {
-  if constexpr (std::is_same_v<T, JNodeString>) {
-    if (jNodeVariant.getNodeType() != JNodeType::string) {
-      throw JNode::Error("Node not a string.");
-    }
-  } else if constexpr (std::is_same_v<T, JNodeNumber>) {
-    if (jNodeVariant.getNodeType() != JNodeType::number) {
-      throw JNode::Error("Node not a number.");
-    }
-  } else if constexpr (std::is_same_v<T, JNodeArray>) {
-    if (jNodeVariant.getNodeType() != JNodeType::array) {
-      throw JNode::Error("Node not an array.");
-    }
-  } else if constexpr (std::is_same_v<T, JNodeObject>) {
-    if (jNodeVariant.getNodeType() != JNodeType::object) {
-      throw JNode::Error("Node not an object.");
-    }
-  } else if constexpr (std::is_same_v<T, JNodeBoolean>) {
-    if (jNodeVariant.getNodeType() != JNodeType::boolean) {
-      throw JNode::Error("Node not an boolean.");
-    }
-  } else if constexpr (std::is_same_v<T, JNodeNull>) {
-    if (jNodeVariant.getNodeType() != JNodeType::null) {
-      throw JNode::Error("Node not a null.");
-    }
+  // Memory resource for any object/array the hole becomes
+  [[nodiscard]] std::pmr::memory_resource *resource() const {
+    return (m_resource);
   }
-}
-template <typename T> T &JNodeRef(JNode &jNode) {
-  CheckJNodeType<T>(*jNode.getJNodeVariant());
-  return (static_cast<T &>(*jNode.getJNodeVariant()));
-}
-template <typename T> const T &JNodeRef(const JNode &jNode) {
-  CheckJNodeType<T>(*jNode.getJNodeVariant());
-  return (static_cast<const T &>(*jNode.getJNodeVariant()));
-}
-} // namespace JSONLib
\ No newline at end of file
+
+private:
+  std::pmr::memory_resource *m_resource;
+};
+} // namespace JSONLib
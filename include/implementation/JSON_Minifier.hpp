@@ -0,0 +1,63 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <cstddef>
+#include <memory>
+#include <string>
+// =============================
+// Source/Destination interfaces
+// =============================
+#include "IDestination.hpp"
+#include "ISource.hpp"
+#include "ITranslator.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_Minifier {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // Size of blocks read from source
+  static constexpr std::size_t kBlockSize{64 * 1024};
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  explicit JSON_Minifier(ITranslator &translator);
+  JSON_Minifier(const JSON_Minifier &other) = delete;
+  JSON_Minifier &operator=(const JSON_Minifier &other) = delete;
+  JSON_Minifier(JSON_Minifier &&other) = delete;
+  JSON_Minifier &operator=(JSON_Minifier &&other) = delete;
+  ~JSON_Minifier() = default;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  void strip(ISource &source, IDestination &destination);
+  // Find first whitespace or quote (outside string) or first quote or
+  // backslash (inside string) in [begin, end); returns end if none.
+  static const char *findSpecial(const char *begin, const char *end,
+                                 bool inString);
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Translator used to check escapes
+  ITranslator &m_translator;
+  // Block read from source
+  std::unique_ptr<char[]> m_block;
+};
+} // namespace JSONLib
@@ -0,0 +1,81 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_NumberScanner {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // Kind of number scanned (none if it is left to the general parser)
+  enum class Kind : std::uint8_t { none = 0, integer, floatingPoint };
+  // Number scanned from text
+  struct Number {
+    Kind kind{Kind::none};
+    std::int64_t integer{};
+    double floatingPoint{};
+  };
+  // Run of numbers scanned from text
+  struct Run {
+    Kind kind{Kind::none};
+    // Characters up to the closing bracket
+    std::size_t length{};
+  };
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  JSON_NumberScanner() = delete;
+  JSON_NumberScanner(const JSON_NumberScanner &other) = delete;
+  JSON_NumberScanner &operator=(const JSON_NumberScanner &other) = delete;
+  JSON_NumberScanner(JSON_NumberScanner &&other) = delete;
+  JSON_NumberScanner &operator=(JSON_NumberScanner &&other) = delete;
+  ~JSON_NumberScanner() = delete;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  // Load eight characters as a little endian word
+  static std::uint64_t loadEight(const char *characters);
+  // Are all eight characters of a word digits ?
+  static bool isEightDigits(std::uint64_t word);
+  // Value of eight digits held in a word
+  static std::uint32_t parseEightDigits(std::uint64_t word);
+  // Scan the number at the start of text; returns its length (zero if
+  // it is not strictly formed or does not fit an int64_t/double).
+  static std::size_t scan(std::string_view text, Number &number);
+  // Scan a run of same kind numbers ending in ']' at the start of text
+  // into integers or floatingPoints (kind none if there is no such run).
+  static Run scanRun(std::string_view text, std::vector<std::int64_t> &integers,
+                     std::vector<double> &floatingPoints);
+  // Narrow scanned floating point values to the floats std::stof gives for
+  // the same text (false if any value is not certain to read as a float).
+  static bool toFloats(const std::vector<double> &floatingPoints,
+                       std::vector<float> &floats);
+  // Are all scanned floating point values certain to be out of float
+  // range (so read as doubles) ?
+  static bool beyondFloat(const std::vector<double> &floatingPoints);
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+};
+} // namespace JSONLib
@@ -2,9 +2,11 @@
 // =======
 // C++ STL
 // =======
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <string_view>
 
 // ================
 // Source interface
@@ -54,6 +56,22 @@ public:
   [[nodiscard]] std::size_t position() const override {
     return (m_bufferPosition);
   }
+  std::size_t read(char *buffer, std::size_t size) override {
+    const std::size_t count =
+        std::min(size, m_parseBuffer.size() - m_bufferPosition);
+    m_parseBuffer.copy(buffer, count, m_bufferPosition);
+    m_bufferPosition += count;
+    return (count);
+  }
+  [[nodiscard]] std::string_view buffered() const override {
+    return (std::string_view{m_parseBuffer}.substr(m_bufferPosition));
+  }
+  void skip(std::size_t length) override {
+    if (length > m_parseBuffer.size() - m_bufferPosition) {
+      throw Error("Tried to read past and of buffer.");
+    }
+    m_bufferPosition += length;
+  }
 
 private:
   std::size_t m_bufferPosition = 0;
@@ -81,7 +99,7 @@ public:
   }
   bool more() const override { return (m_source.peek() != EOF); }
   void backup(unsigned long length) override {
-    if ((length <= m_source.tellg()) ||
+    if ((static_cast<long>(length) <= m_source.tellg()) ||
         (current() == (char)EOF)) {
       m_source.clear();
       m_source.seekg(-static_cast<long>(length), std::ios_base::cur);
@@ -99,6 +117,10 @@ public:
     }
     return (std::filesystem::file_size(m_sourceFileName));
   }
+  std::size_t read(char *buffer, std::size_t size) override {
+    m_source.read(buffer, static_cast<std::streamsize>(size));
+    return (static_cast<std::size_t>(m_source.gcount()));
+  }
 
 private:
   mutable std::ifstream m_source;
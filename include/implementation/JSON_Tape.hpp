@@ -0,0 +1,170 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+// =============================
+// Source/Translator interfaces
+// =============================
+#include "ISource.hpp"
+#include "ITranslator.hpp"
+// ====
+// JSON
+// ====
+#include "JSON_Converter.hpp"
+#include "JSON_Translator.hpp"
+#include "JSON_Types.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_Tape {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // ==============================================================
+  // Tape entry tags (held in the top byte of each 64 bit entry).
+  // Containers hold the index of their matching end entry and the
+  // end entry holds the number of children. Numbers take two entries
+  // the second being the raw 64 bit value.
+  // ==============================================================
+  enum class Tag : char {
+    object = '{',
+    objectEnd = '}',
+    array = '[',
+    arrayEnd = ']',
+    string = '"',
+    integer = 'l',
+    floatingPoint = 'd',
+    booleanTrue = 't',
+    booleanFalse = 'f',
+    null = 'n'
+  };
+  static constexpr int kTagShift{56};
+  static constexpr std::uint64_t kPayloadMask{(1ull << kTagShift) - 1};
+  // =======================================
+  // Read only JNode like view onto the tape
+  // =======================================
+  class View {
+  public:
+    // Child iterator (for objects each step covers a key/value pair)
+    class Iterator {
+    public:
+      Iterator(const JSON_Tape *tape, std::size_t index, bool object)
+          : m_tape(tape), m_index(index), m_object(object) {}
+      View operator*() const {
+        return (View{m_tape, m_object ? m_index + 1 : m_index});
+      }
+      [[nodiscard]] std::string_view key() const;
+      Iterator &operator++();
+      bool operator==(const Iterator &other) const {
+        return (m_index == other.m_index);
+      }
+
+    private:
+      const JSON_Tape *m_tape;
+      std::size_t m_index;
+      bool m_object;
+    };
+    View(const JSON_Tape *tape, std::size_t index)
+        : m_tape(tape), m_index(index) {}
+    // Get node type
+    [[nodiscard]] JNodeType getNodeType() const;
+    // Number of entries in an object/array
+    [[nodiscard]] std::size_t size() const;
+    // Object/array indexing
+    View operator[](const std::string_view &key) const;
+    View operator[](std::size_t index) const;
+    [[nodiscard]] bool contains(const std::string_view &key) const;
+    // Scalar values
+    [[nodiscard]] std::string_view string() const;
+    [[nodiscard]] bool isLLong() const { return (tag() == Tag::integer); }
+    [[nodiscard]] bool isDouble() const {
+      return (tag() == Tag::floatingPoint);
+    }
+    [[nodiscard]] long long getLLong() const;
+    [[nodiscard]] double getDouble() const;
+    [[nodiscard]] bool boolean() const;
+    // Iterate over children of an object/array
+    [[nodiscard]] Iterator begin() const;
+    [[nodiscard]] Iterator end() const;
+    // Tape index of node
+    [[nodiscard]] std::size_t index() const { return (m_index); }
+
+  private:
+    [[nodiscard]] Tag tag() const { return (m_tape->tag(m_index)); }
+    const JSON_Tape *m_tape;
+    std::size_t m_index;
+  };
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  JSON_Tape();
+  JSON_Tape(const JSON_Tape &other) = delete;
+  JSON_Tape &operator=(const JSON_Tape &other) = delete;
+  JSON_Tape(JSON_Tape &&other) = delete;
+  JSON_Tape &operator=(JSON_Tape &&other) = delete;
+  ~JSON_Tape() = default;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  void parse(ISource &source);
+  void parse(ISource &&source);
+  [[nodiscard]] View root() const;
+  [[nodiscard]] Tag tag(std::size_t index) const {
+    return (static_cast<Tag>(m_tape[index] >> kTagShift));
+  }
+  [[nodiscard]] std::uint64_t payload(std::size_t index) const {
+    return (m_tape[index] & kPayloadMask);
+  }
+  [[nodiscard]] std::size_t skip(std::size_t index) const;
+  [[nodiscard]] std::string_view string(std::size_t index) const;
+  [[nodiscard]] const std::vector<std::uint64_t> &tape() const {
+    return (m_tape);
+  }
+  [[nodiscard]] const std::string &strings() const { return (m_strings); }
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  void append(Tag tag, std::uint64_t payload);
+  void appendString(ISource &source);
+  void appendInteger(long long integer);
+  void appendFloatingPoint(double floatingPoint);
+  void parseKeyValuePair(ISource &source);
+  void parseNumber(ISource &source);
+  void parseObject(ISource &source);
+  void parseArray(ISource &source);
+  void parseValue(ISource &source);
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Tape entries
+  std::vector<std::uint64_t> m_tape;
+  // String buffer (each string has a 64 bit length prefix so that strings
+  // of 4GB or more are held intact)
+  std::string m_strings;
+  // Scratch buffer for numbers that are not converted in place
+  std::string m_numberScratch;
+  // Scratch buffer for strings whose escapes are being translated
+  std::string m_stringScratch;
+  // Translator for string escapes
+  JSON_Converter m_converter;
+  JSON_Translator m_translator;
+};
+} // namespace JSONLib
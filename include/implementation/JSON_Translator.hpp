@@ -5,7 +5,7 @@
 #include <array>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 // ===============================
 // Translator/Converter interfaces
@@ -46,6 +46,10 @@ public:
   std::string fromJSON(const std::string &jsonString) override;
   std::string toJSON(const std::string &utf8String) override;
   bool validEscape(char escape) override;
+  // Maximum bytes escape() may write per byte of input
+  static constexpr std::size_t kMaxEscapedBytes{6};
+  static char *escape(const std::string_view &utf8String, char *destination);
+  static std::size_t escapedSize(const std::string_view &utf8String);
   // ================
   // PUBLIC VARIABLES
   // ================
@@ -61,8 +65,5 @@ private:
   // =================
   // Character converter
   const IConverter &m_converter;
-  // To/From escape sequence lookup maps
-  std::unordered_map<char, char16_t> m_fromEscape;
-  std::unordered_map<char16_t, char> m_toEscape;
 };
 } // namespace JSONLib
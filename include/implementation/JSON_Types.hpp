@@ -3,7 +3,7 @@
 // JSON core definitions
 // =====================
 #include "JSON_Error.hpp"
-#include "JSON_JNode.hpp"
 #include "JSON_JNodeNumeric.hpp"
 #include "JSON_JNodeVariant.hpp"
+#include "JSON_JNode.hpp"
 #include "JSON_JNodeCreation.hpp"
\ No newline at end of file
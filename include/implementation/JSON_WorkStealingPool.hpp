@@ -0,0 +1,81 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSON_WorkStealingPool {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // Task run for each index of a batch
+  using Task = std::function<void(std::size_t)>;
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  explicit JSON_WorkStealingPool(
+      std::size_t threads = std::thread::hardware_concurrency());
+  JSON_WorkStealingPool(const JSON_WorkStealingPool &other) = delete;
+  JSON_WorkStealingPool &operator=(const JSON_WorkStealingPool &other) = delete;
+  JSON_WorkStealingPool(JSON_WorkStealingPool &&other) = delete;
+  JSON_WorkStealingPool &operator=(JSON_WorkStealingPool &&other) = delete;
+  ~JSON_WorkStealingPool();
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  static JSON_WorkStealingPool &instance();
+  void run(std::size_t count, const Task &task);
+  [[nodiscard]] std::size_t threads() const { return (m_queues.size()); }
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // Range of batch indices initially assigned to a thread; the owner and
+  // any thieves claim indices from it by advancing next.
+  struct Queue {
+    alignas(64) std::atomic<std::size_t> next{};
+    std::size_t end{};
+  };
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  void worker(std::size_t queue);
+  void process(std::size_t queue);
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Per thread queues (the last one belongs to the calling thread)
+  std::vector<Queue> m_queues;
+  std::vector<std::thread> m_workers;
+  // Current batch task, generation and number of workers still busy
+  const Task *m_task{};
+  std::size_t m_generation{};
+  std::size_t m_busy{};
+  bool m_stop{};
+  // Held while the workers process a batch (other batches run inline)
+  std::mutex m_runMutex;
+  // ==true then the current thread is running a task of some batch
+  static thread_local bool m_inBatch;
+  std::mutex m_mutex;
+  std::condition_variable m_batchStarted;
+  std::condition_variable m_batchFinished;
+};
+} // namespace JSONLib
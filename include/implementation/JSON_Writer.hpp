@@ -0,0 +1,120 @@
+#pragma once
+// =======
+// C++ STL
+// =======
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+// ===============================
+// Destination/Translator interfaces
+// ===============================
+#include "IDestination.hpp"
+#include "ITranslator.hpp"
+// ====
+// JSON
+// ====
+#include "JSON_Converter.hpp"
+#include "JSON_Translator.hpp"
+#include "JSON_Types.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace JSONLib {
+// ================
+// CLASS DEFINITION
+// ================
+class JSONWriter {
+public:
+  // ==========================
+  // PUBLIC TYPES AND CONSTANTS
+  // ==========================
+  // =================
+  // JSON writer error
+  // =================
+  struct Error : public std::runtime_error {
+    explicit Error(const std::string &message)
+        : std::runtime_error("JSONWriter Error: " + message) {}
+  };
+  // ======================
+  // CONSTRUCTOR/DESTRUCTOR
+  // ======================
+  explicit JSONWriter(IDestination &destination,
+                      ITranslator *translator = nullptr);
+  JSONWriter(const JSONWriter &other) = delete;
+  JSONWriter &operator=(const JSONWriter &other) = delete;
+  JSONWriter(JSONWriter &&other) = delete;
+  JSONWriter &operator=(JSONWriter &&other) = delete;
+  ~JSONWriter() = default;
+  // ==============
+  // PUBLIC METHODS
+  // ==============
+  JSONWriter &beginObject();
+  JSONWriter &endObject();
+  JSONWriter &beginArray();
+  JSONWriter &endArray();
+  JSONWriter &key(std::string_view key);
+  JSONWriter &value(std::string_view string);
+  // Kept so that string literals are not taken as bool; nullptr is null
+  JSONWriter &value(const char *string);
+  JSONWriter &value(char character);
+  JSONWriter &value(bool boolean);
+  JSONWriter &value(std::nullptr_t null);
+  // Wide character types have no single byte string form so are rejected
+  // rather than written as their code unit value (or converted to bool).
+  JSONWriter &value(wchar_t character) = delete;
+  JSONWriter &value(char8_t character) = delete;
+  JSONWriter &value(char16_t character) = delete;
+  JSONWriter &value(char32_t character) = delete;
+  template <typename T>
+  requires(Integer<T> || Float<T>) && (!std::is_same_v<T, bool>) &&
+          (!std::is_same_v<T, char>)
+  JSONWriter &value(T number) {
+    beginValue();
+    auto buffer = m_destination.prepare(JNodeNumeric::kMaxCharacters);
+    const char *end = JNodeNumeric::numericToChars(
+        buffer.data(), buffer.data() + buffer.size(), number);
+    m_destination.commit(end - buffer.data());
+    return (*this);
+  }
+  template <typename T> JSONWriter &member(std::string_view name, T &&data) {
+    key(name);
+    return (value(std::forward<T>(data)));
+  }
+  void flush();
+  [[nodiscard]] bool complete() const;
+  // ================
+  // PUBLIC VARIABLES
+  // ================
+private:
+  // ===========================
+  // PRIVATE TYPES AND CONSTANTS
+  // ===========================
+  // ===============
+  // PRIVATE METHODS
+  // ===============
+  void beginValue();
+  void endContainer(char close);
+  void addString(std::string_view string);
+  // =================
+  // PRIVATE VARIABLES
+  // =================
+  // Destination for JSON
+  IDestination &m_destination;
+  // Open containers ('{' or '[')
+  std::vector<char> m_containers;
+  // ==true then next entry in current container is its first
+  bool m_first{true};
+  // ==true then a key has been written and its value is expected
+  bool m_keyWritten{false};
+  // ==true then a complete top level value has been written
+  bool m_rootWritten{false};
+  // Translator for string escapes (default or custom)
+  JSON_Converter m_converter;
+  std::unique_ptr<ITranslator> m_translator;
+  // ==true then default translator so escape directly into destination
+  bool m_escapeDirect{};
+};
+} // namespace JSONLib
@@ -2,7 +2,11 @@
 // =======
 // C++ STL
 // =======
+#include <cstddef>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 // =========
 // NAMESPACE
 // =========
@@ -36,9 +40,53 @@ public:
   // Add character to destination
   // ============================
   virtual void add(char ch) = 0;
+  // =====================================================================
+  // Add a run of bytes to destination (override to avoid the temporary)
+  // =====================================================================
+  virtual void add(const char *bytes, std::size_t length) {
+    add(std::string{bytes, length});
+  }
+  // ====================================================================
+  // Add several runs of bytes in order (a gather write). The default adds
+  // each run in turn; destinations that can take them together override.
+  // ====================================================================
+  virtual void add(std::span<const std::string_view> runs) {
+    for (const auto &run : runs) {
+      add(run.data(), run.size());
+    }
+  }
   // ============================
   // Clear the curent destination
   // ===========================
   virtual void clear() = 0;
+  // =======================================================
+  // Write out anything buffered (called at end of stringify)
+  // =======================================================
+  virtual void flush() {}
+  // ======================================================================
+  // Reserve space for the number of bytes about to be added. This is only
+  // called if usesReserve() returns true as estimating the size of the
+  // output requires an extra traversal of the JNode tree.
+  // ======================================================================
+  virtual void reserve([[maybe_unused]] std::size_t size) {}
+  [[nodiscard]] virtual bool usesReserve() const { return (false); }
+  // =====================================================================
+  // Zero copy writes: prepare() returns writable space for up to size
+  // bytes and commit() then adds the first length bytes written to it.
+  // Nothing else may be added between the two calls. The default writes
+  // into a scratch buffer and adds it on commit; destinations that own
+  // their memory override both so data is written into them in place.
+  // =====================================================================
+  virtual std::span<char> prepare(std::size_t size) {
+    if (m_prepared.size() < size) {
+      m_prepared.resize(size);
+    }
+    return (std::span<char>{m_prepared.data(), size});
+  }
+  virtual void commit(std::size_t length) { add(m_prepared.data(), length); }
+
+private:
+  // Scratch buffer for default prepare()/commit()
+  std::string m_prepared;
 };
 } // namespace JSONLib
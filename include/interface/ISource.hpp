@@ -1,5 +1,8 @@
 #pragma once
+#include <cstddef>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 // =========
 // NAMESPACE
 // =========
@@ -49,6 +52,32 @@ public:
   // Current character position within source stream
   // ===============================================
   [[nodiscard]] virtual std::size_t position() const = 0;
+  // ======================================================================
+  // Read up to size characters into buffer advancing past them; returns
+  // number read (zero at end). Override for sources that can copy blocks.
+  // ======================================================================
+  virtual std::size_t read(char *buffer, std::size_t size) {
+    std::size_t count{};
+    while (count < size && more()) {
+      buffer[count++] = current();
+      next();
+    }
+    return (count);
+  }
+  // ======================================================================
+  // Characters from the current position on that are already held in
+  // memory (none by default). Override for sources that can expose their
+  // buffer; the view is valid until the source is next moved.
+  // ======================================================================
+  [[nodiscard]] virtual std::string_view buffered() const { return {}; }
+  // ===========================
+  // Move past length characters
+  // ===========================
+  virtual void skip(std::size_t length) {
+    while (length-- > 0) {
+      next();
+    }
+  }
   // ===================================
   // Is the current character whitespace
   // ===================================
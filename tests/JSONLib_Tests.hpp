@@ -16,9 +16,11 @@
 // =======
 // C++ STL
 // =======
+#include <atomic>
 #include <climits>
 #include <filesystem>
 #include <limits>
+#include <memory_resource>
 #include <sstream>
 #include <string>
 #include <iostream>
@@ -26,9 +28,34 @@
 // ===================
 // Unit test constants
 // ===================
-inline static const char *kGeneratedJSONFile = "generated.json";
-inline static const char *kSingleJSONFile = "testfile001.json";
-inline static const char *kNonExistantJSONFile = "doesntexist.json";
+inline const char *kGeneratedJSONFile = "generated.json";
+inline const char *kSingleJSONFile = "testfile001.json";
+inline const char *kNonExistantJSONFile = "doesntexist.json";
+// ===================================================================
+// Memory resource that counts allocations and tracks bytes outstanding
+// (atomic as trees may be built and freed on other threads)
+// ===================================================================
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::atomic<std::size_t> allocations{};
+  std::atomic<std::size_t> bytesOutstanding{};
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    allocations++;
+    bytesOutstanding += bytes;
+    return (std::pmr::new_delete_resource()->allocate(bytes, alignment));
+  }
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    bytesOutstanding -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  [[nodiscard]] bool
+  do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return (this == &other);
+  }
+};
 // ==========================
 // Unit test helper functions
 // ==========================
@@ -56,7 +83,7 @@ std::string stripWhiteSpace(const JSONLib::JSON &json, const std::string &jsonBu
       "testfile011.json",                                                      \
       "testfile012.json"                                                      \
   }))
-//      "testfile013.json",                                                      \
+//      "testfile013.json",
 // FLoating point comparison (accurate to within an epsilon)
 template <typename T> bool equalFloatingPoint(T a, T b, double epsilon) {
   return (std::fabs(a - b) <= epsilon);
@@ -0,0 +1,208 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON allocation count regression tests using the Catch2
+// test framework. Global operator new/delete are replaced (for the whole
+// test executable) so that every heap allocation made on the calling
+// thread is counted; a counting memory resource also records allocations
+// made for the JNode tree. Parsing and stringifying the generated corpus
+// must stay within the budgets below.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Generator.hpp"
+// =======
+// C++ STL
+// =======
+#include <cstdlib>
+#include <new>
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ======================================================
+// Allocations made by operator new on the current thread
+// ======================================================
+static thread_local std::size_t heapAllocations{};
+static void *allocate(std::size_t size, std::size_t alignment) {
+  heapAllocations++;
+  void *memory = alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                     ? std::malloc(size != 0 ? size : 1)
+                     : std::aligned_alloc(alignment, (size + alignment - 1) /
+                                                         alignment * alignment);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return (memory);
+}
+static void *allocate(std::size_t size, std::size_t alignment,
+                      [[maybe_unused]] const std::nothrow_t &nothrow) noexcept {
+  try {
+    return (allocate(size, alignment));
+  } catch ([[maybe_unused]] const std::bad_alloc &e) {
+    return (nullptr);
+  }
+}
+// All forms are replaced so that every allocation is paired with free()
+// (sanitizers check that allocation and deallocation functions match).
+void *operator new(std::size_t size) {
+  return (allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__));
+}
+void *operator new[](std::size_t size) {
+  return (allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__));
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return (allocate(size, static_cast<std::size_t>(alignment)));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return (allocate(size, static_cast<std::size_t>(alignment)));
+}
+void *operator new(std::size_t size, const std::nothrow_t &nothrow) noexcept {
+  return (allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, nothrow));
+}
+void *operator new[](std::size_t size, const std::nothrow_t &nothrow) noexcept {
+  return (allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, nothrow));
+}
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &nothrow) noexcept {
+  return (allocate(size, static_cast<std::size_t>(alignment), nothrow));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &nothrow) noexcept {
+  return (allocate(size, static_cast<std::size_t>(alignment), nothrow));
+}
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, [[maybe_unused]] std::size_t size) noexcept {
+  std::free(memory);
+}
+void operator delete[](void *memory,
+                       [[maybe_unused]] std::size_t size) noexcept {
+  std::free(memory);
+}
+void operator delete(void *memory,
+                     [[maybe_unused]] std::align_val_t alignment) noexcept {
+  std::free(memory);
+}
+void operator delete[](void *memory,
+                       [[maybe_unused]] std::align_val_t alignment) noexcept {
+  std::free(memory);
+}
+void operator delete(void *memory, [[maybe_unused]] std::size_t size,
+                     [[maybe_unused]] std::align_val_t alignment) noexcept {
+  std::free(memory);
+}
+void operator delete[](void *memory, [[maybe_unused]] std::size_t size,
+                       [[maybe_unused]] std::align_val_t alignment) noexcept {
+  std::free(memory);
+}
+void operator delete(void *memory,
+                     [[maybe_unused]] const std::nothrow_t &nothrow) noexcept {
+  std::free(memory);
+}
+void operator delete[](void *memory,
+                       [[maybe_unused]] const std::nothrow_t &nothrow) noexcept {
+  std::free(memory);
+}
+void operator delete(void *memory,
+                     [[maybe_unused]] std::align_val_t alignment,
+                     [[maybe_unused]] const std::nothrow_t &nothrow) noexcept {
+  std::free(memory);
+}
+void operator delete[](void *memory,
+                       [[maybe_unused]] std::align_val_t alignment,
+                       [[maybe_unused]] const std::nothrow_t &nothrow) noexcept {
+  std::free(memory);
+}
+// ==================================================================
+// Allocation budgets for the generated corpus (64KB of each shape).
+// Parse budgets are per KB of JSON text (nodes are not a stable measure
+// as packed arrays hold numbers without them); heap counts every
+// allocation made while parsing (tree plus any temporaries) and tree only
+// those made from the JNode tree memory resource (so can be no larger than
+// the heap budget). Other budgets are per document. Lower these when an
+// optimization reduces allocations so that it is kept.
+// ==================================================================
+struct AllocationBudget {
+  JSON_Generator::Shape shape;
+  double parseHeapPerKB;
+  double parseTreePerKB;
+};
+static const std::vector<AllocationBudget> kAllocationBudgets{
+    {JSON_Generator::Shape::records, 100, 78},
+    {JSON_Generator::Shape::numeric, 63, 62},
+    {JSON_Generator::Shape::nested, 153, 127},
+    {JSON_Generator::Shape::escapes, 77, 25},
+    {JSON_Generator::Shape::wide, 81, 48}};
+// Stringify into a destination with enough capacity
+constexpr std::size_t kStringifyBudget{0};
+// Strip/validate from a buffer source
+constexpr std::size_t kStripBudget{4};
+constexpr std::size_t kValidateBudget{4};
+// ===============
+// Local functions
+// ===============
+/// <summary>
+/// Return heap allocations made on this thread while running an action.
+/// </summary>
+/// <param name="action">Action to run.</param>
+/// <returns>Number of allocations.</returns>
+template <typename T> static std::size_t countAllocations(T &&action) {
+  const std::size_t before = heapAllocations;
+  action();
+  return (heapAllocations - before);
+}
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Check allocation counts for the generated corpus are within "
+          "budget.",
+          "[JSON][Allocations]") {
+  auto budget = GENERATE(from_range(kAllocationBudgets));
+  const std::string jsonText{JSON_Generator{budget.shape}.generate(64 * 1024)};
+  CountingResource resource;
+  const JSON json(nullptr, nullptr, &resource);
+  // First parse so scratch buffers have grown
+  json.parse(BufferSource{jsonText});
+  const auto kiloBytes = static_cast<double>(jsonText.size()) / 1024;
+  INFO("Shape " << JSON_Generator::name(budget.shape) << ".");
+  SECTION("Parse and check allocations per KB.",
+          "[JSON][Allocations][Parse]") {
+    resource.allocations = 0;
+    const auto heap = static_cast<double>(
+        countAllocations([&] { json.parse(BufferSource{jsonText}); }));
+    const auto tree = static_cast<double>(resource.allocations);
+    INFO("Heap allocations per KB " << heap / kiloBytes << ".");
+    INFO("Tree allocations per KB " << tree / kiloBytes << ".");
+    REQUIRE(budget.parseTreePerKB <= budget.parseHeapPerKB);
+    REQUIRE(heap / kiloBytes <= budget.parseHeapPerKB);
+    REQUIRE(tree / kiloBytes <= budget.parseTreePerKB);
+  }
+  SECTION("Stringify and check allocations.", "[JSON][Allocations][Stringify]") {
+    BufferDestination destination{jsonText.size() * 2};
+    REQUIRE(countAllocations([&] { json.stringify(destination); }) <=
+            kStringifyBudget);
+  }
+  SECTION("Stringify into an empty buffer and check it is allocated once.",
+          "[JSON][Allocations][Reserve]") {
+    BufferDestination destination;
+    REQUIRE(countAllocations([&] { json.stringify(destination); }) == 1);
+    // Estimates are exact except for floating point upper bounds
+    REQUIRE(destination.capacity() >= destination.size());
+    REQUIRE(destination.capacity() <= destination.size() * 3 / 2);
+  }
+  SECTION("Strip and validate and check allocations.",
+          "[JSON][Allocations][Strip]") {
+    BufferDestination destination{jsonText.size()};
+    REQUIRE(countAllocations([&] {
+              json.strip(BufferSource{jsonText}, destination);
+            }) <= kStripBudget);
+    bool valid{};
+    REQUIRE(countAllocations([&] {
+              valid = json.validate(BufferSource{jsonText}).valid;
+            }) <= kValidateBudget);
+    REQUIRE(valid);
+  }
+}
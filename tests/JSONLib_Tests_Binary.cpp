@@ -0,0 +1,98 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON binary encoding unit tests using the Catch2 test
+// framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Binary.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Encode JNode tree to binary and reload it.", "[JSON][Binary]") {
+  const JSON json;
+  SECTION("Encode test files and check reloaded tree stringifies the same.",
+          "[JSON][Binary][Files]") {
+    TEST_FILE_LIST(testFile);
+    json.parse(FileSource{prefixTestDataPath(testFile)});
+    BufferDestination expected;
+    json.stringify(expected);
+    BufferDestination binary;
+    json.stringifyBinary(binary);
+    const JSON reloaded;
+    reloaded.parseBinary(BufferSource{binary.getBuffer()});
+    BufferDestination actual;
+    reloaded.stringify(actual);
+    REQUIRE(actual.getBuffer() == expected.getBuffer());
+  }
+  SECTION("Encode numbers and check their exact types are preserved.",
+          "[JSON][Binary][Numbers]") {
+    json.parse(BufferSource{
+        R"([1,-2147483649,3.5,1e308,"1é\t",true,false,null,{},[]])"});
+    BufferDestination binary;
+    json.stringifyBinary(binary);
+    const JSON reloaded;
+    reloaded.parseBinary(BufferSource{binary.getBuffer()});
+    const auto &array = reloaded.root();
+    for (std::size_t index = 0; index < 4; index++) {
+      const auto &expected = JNodeRef<JNodeNumber>(json.root()[index]).number();
+      const auto &actual = JNodeRef<JNodeNumber>(array[index]).number();
+      REQUIRE(actual.isInt() == expected.isInt());
+      REQUIRE(actual.isLong() == expected.isLong());
+      REQUIRE(actual.isLLong() == expected.isLLong());
+      REQUIRE(actual.isFloat() == expected.isFloat());
+      REQUIRE(actual.isDouble() == expected.isDouble());
+      REQUIRE(actual.isLDouble() == expected.isLDouble());
+      REQUIRE(actual.getString() == expected.getString());
+    }
+    REQUIRE(JNodeRef<JNodeString>(array[4]).string() ==
+            JNodeRef<JNodeString>(json.root()[4]).string());
+    REQUIRE(JNodeRef<JNodeBoolean>(array[5]).boolean());
+    REQUIRE_FALSE(JNodeRef<JNodeBoolean>(array[6]).boolean());
+    REQUIRE(array[7].getNodeType() == JNodeType::null);
+    REQUIRE(JNodeRef<JNodeObject>(array[8]).size() == 0);
+    REQUIRE(JNodeRef<JNodeArray>(array[9]).size() == 0);
+  }
+  SECTION("Encode created numeric types and check they are preserved.",
+          "[JSON][Binary][Created]") {
+    JSON created;
+    created[0] = 3.0f;
+    created[1] = 123456789012LL;
+    created[2] = 0.1L;
+    BufferDestination binary;
+    created.stringifyBinary(binary);
+    json.parseBinary(BufferSource{binary.getBuffer()});
+    REQUIRE(JNodeRef<JNodeNumber>(json.root()[0]).number().isFloat());
+    REQUIRE(JNodeRef<JNodeNumber>(json.root()[0]).number().getFloat() == 3.0f);
+    REQUIRE(JNodeRef<JNodeNumber>(json.root()[1]).number().getLLong() ==
+            123456789012LL);
+    REQUIRE(JNodeRef<JNodeNumber>(json.root()[2]).number().isLDouble());
+    REQUIRE(JNodeRef<JNodeNumber>(json.root()[2]).number().getLDouble() ==
+            0.1L);
+  }
+  SECTION("Reload invalid binary and check exceptions.",
+          "[JSON][Binary][Exceptions]") {
+    json.parse(BufferSource{R"({"City":"Southampton","Population":500000})"});
+    BufferDestination binary;
+    json.stringifyBinary(binary);
+    const std::string encoding{binary.getBuffer()};
+    REQUIRE_THROWS_WITH(json.parseBinary(BufferSource{"JNB0{\x00"}),
+                        "JSON Binary Error: Invalid header.");
+    REQUIRE_THROWS_WITH(
+        json.parseBinary(BufferSource{encoding.substr(0, encoding.size() - 2)}),
+        "JSON Binary Error: Unexpected end of encoding.");
+    REQUIRE_THROWS_WITH(json.parseBinary(BufferSource{"JNB1?"}),
+                        "JSON Binary Error: Invalid node tag.");
+    REQUIRE_THROWS_WITH(
+        json.parseBinary(BufferSource{std::string{"JNB1\"\xff\xff\xff\x7f", 8}}),
+        "JSON Binary Error: Unexpected end of encoding.");
+    checkObject(json.root());
+  }
+}
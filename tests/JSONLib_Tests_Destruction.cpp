@@ -0,0 +1,99 @@
+//
+// Unit Tests: JSON
+//
+// Description: JNode tree destruction unit tests using the Catch2 test
+// framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include <atomic>
+#include <thread>
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==================================================================
+// Memory resource that records deallocations made on another thread
+// ==================================================================
+class ThreadCheckingResource : public std::pmr::memory_resource {
+public:
+  std::atomic<bool> otherThread{};
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return (std::pmr::new_delete_resource()->allocate(bytes, alignment));
+  }
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    if (std::this_thread::get_id() != m_owner) {
+      otherThread = true;
+    }
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  [[nodiscard]] bool
+  do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return (this == &other);
+  }
+  std::thread::id m_owner{std::this_thread::get_id()};
+};
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Check JNode tree destruction.", "[JSON][Destruction]") {
+  CountingResource resource;
+  SECTION("Destroy a very deeply nested array without overflowing the stack.",
+          "[JSON][Destruction][Deep]") {
+    {
+      JNode::Ptr jNodeRoot = makeNull(&resource);
+      for (int depth = 0; depth < 200000; depth++) {
+        JNodeArray::ArrayList array{&resource};
+        array.emplace_back(std::move(jNodeRoot));
+        jNodeRoot = makeArray(array, &resource);
+      }
+      REQUIRE(resource.bytesOutstanding > 0);
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Destroy a tree with nested objects, arrays and strings.",
+          "[JSON][Destruction][Mixed]") {
+    {
+      const JSON json(nullptr, nullptr, &resource);
+      json.parse(BufferSource{
+          R"({"a":[{"b":[1,2,{"c":"A string too long for small string )"
+          R"(optimisation."}]},[[[]]]],"d":{"e":{"f":null}}})"});
+      REQUIRE(resource.bytesOutstanding > 0);
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Defer destruction of parsed trees to the reclaimer thread.",
+          "[JSON][Destruction][Deferred]") {
+    auto *defaultResource = std::pmr::set_default_resource(&resource);
+    {
+      const JSON json;
+      json.deferDestruction(true);
+      TEST_FILE_LIST(testFile);
+      json.parse(FileSource{prefixTestDataPath(testFile)});
+      json.parse(FileSource{prefixTestDataPath(testFile)});
+      REQUIRE(resource.bytesOutstanding > 0);
+    }
+    JSON::flushDestruction();
+    std::pmr::set_default_resource(defaultResource);
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Destroy trees from an unsynchronized resource on the owning "
+          "thread even if destruction is deferred.",
+          "[JSON][Destruction][Unsynchronized]") {
+    ThreadCheckingResource checking;
+    {
+      const JSON json(nullptr, nullptr, &checking);
+      json.deferDestruction(true);
+      TEST_FILE_LIST(testFile);
+      json.parse(FileSource{prefixTestDataPath(testFile)});
+      json.parse(FileSource{prefixTestDataPath(testFile)});
+    }
+    JSON::flushDestruction();
+    REQUIRE_FALSE(checking.otherThread);
+  }
+}
@@ -0,0 +1,118 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON parsed document cache unit tests using the Catch2
+// test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_DocumentCache.hpp"
+// =======
+// C++ STL
+// =======
+#include <chrono>
+#include <thread>
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Cache parsed documents keyed on file identity.",
+          "[JSON][DocumentCache]") {
+  const std::string fileName{prefixTestDataPath("cached.json")};
+  writeToFile(fileName, R"({"City":"Southampton","Population":500000})");
+  SECTION("Get the same file twice and check it is only parsed once.",
+          "[JSON][DocumentCache][Hit]") {
+    DocumentCache cache;
+    auto first = cache.get(fileName);
+    auto second = cache.get(fileName);
+    REQUIRE(first == second);
+    REQUIRE(cache.loads() == 1);
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.memoryUsed() > 0);
+    static_assert(std::is_const_v<DocumentCache::Document::element_type>);
+    checkObject(*first);
+  }
+  SECTION("Change file and check it is reparsed while the old document "
+          "stays usable.",
+          "[JSON][DocumentCache][Changed]") {
+    DocumentCache cache;
+    auto first = cache.get(fileName);
+    writeToFile(fileName, R"({"City":"London","Population":9000000})");
+    auto second = cache.get(fileName);
+    REQUIRE(first != second);
+    REQUIRE(cache.loads() == 2);
+    REQUIRE(cache.size() == 1);
+    REQUIRE(JNodeRef<JNodeString>((*first)["City"]).string() == "Southampton");
+    REQUIRE(JNodeRef<JNodeString>((*second)["City"]).string() == "London");
+  }
+  SECTION("Get the same file from several threads and check it is only "
+          "parsed once.",
+          "[JSON][DocumentCache][Concurrent]") {
+    DocumentCache cache;
+    std::vector<DocumentCache::Document> documents(8);
+    std::vector<std::thread> threads;
+    for (auto &document : documents) {
+      threads.emplace_back(
+          [&cache, &fileName, &document] { document = cache.get(fileName); });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    REQUIRE(cache.loads() == 1);
+    for (auto &document : documents) {
+      REQUIRE(document == documents[0]);
+    }
+  }
+  SECTION("Exceed memory budget and check least recently used documents are "
+          "evicted.",
+          "[JSON][DocumentCache][Evict]") {
+    DocumentCache cache{1};
+    auto first = cache.get(fileName);
+    auto second = cache.get(prefixTestDataPath(kSingleJSONFile));
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.get(prefixTestDataPath(kSingleJSONFile)) == second);
+    REQUIRE(cache.get(fileName) != first);
+    REQUIRE(cache.loads() == 3);
+  }
+  SECTION("Get missing or invalid files and check exceptions.",
+          "[JSON][DocumentCache][Exceptions]") {
+    DocumentCache cache;
+    REQUIRE_THROWS_WITH(cache.get(prefixTestDataPath("missing.json")),
+                        "DocumentCache Error: File does not exist.");
+    writeToFile(fileName, R"({"City":})");
+    REQUIRE_THROWS_WITH(cache.get(fileName),
+                        "JSON Error: Syntax error detected.");
+    REQUIRE(cache.size() == 0);
+  }
+  SECTION("Change file and check background revalidation reloads it.",
+          "[JSON][DocumentCache][Revalidate]") {
+    DocumentCache cache{DocumentCache::kDefaultMemoryBudget,
+                        std::chrono::milliseconds{5}};
+    auto first = cache.get(fileName);
+    writeToFile(fileName, R"({"City":"London","Population":9000000})");
+    for (int wait = 0; wait < 1000 && cache.loads() < 2; wait++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    REQUIRE(cache.loads() == 2);
+    REQUIRE(JNodeRef<JNodeString>((*cache.get(fileName))["City"]).string() ==
+            "London");
+    REQUIRE(cache.loads() == 2);
+    REQUIRE(JNodeRef<JNodeString>((*first)["City"]).string() == "Southampton");
+  }
+  SECTION("Change file and check the cached document is served until "
+          "background revalidation has reloaded it.",
+          "[JSON][DocumentCache][RevalidatePending]") {
+    DocumentCache cache{DocumentCache::kDefaultMemoryBudget,
+                        std::chrono::hours{1}};
+    auto first = cache.get(fileName);
+    writeToFile(fileName, R"({"City":"London","Population":9000000})");
+    REQUIRE(cache.get(fileName) == first);
+    REQUIRE(cache.loads() == 1);
+  }
+  std::filesystem::remove(fileName);
+}
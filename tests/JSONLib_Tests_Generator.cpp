@@ -0,0 +1,56 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON synthetic corpus generator unit tests using the
+// Catch2 test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Generator.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Generate synthetic JSON documents.", "[JSON][Generator]") {
+  auto shape = GENERATE(from_range(JSON_Generator::shapes()));
+  SECTION("Generate a document and check it is valid JSON of the requested "
+          "size.",
+          "[JSON][Generator][Valid]") {
+    const std::string jsonText{JSON_Generator{shape}.generate(64 * 1024)};
+    REQUIRE(jsonText.size() >= 64 * 1024);
+    REQUIRE(jsonText.size() < 64 * 1024 + 8 * 1024);
+    const JSON json;
+    REQUIRE(json.validate(BufferSource{jsonText}));
+    json.parse(BufferSource{jsonText});
+    REQUIRE(json.root().getNodeType() == (shape == JSON_Generator::Shape::wide
+                                              ? JNodeType::object
+                                              : JNodeType::array));
+  }
+  SECTION("Generate documents with the same and different seeds and check "
+          "they are reproducible.",
+          "[JSON][Generator][Seed]") {
+    const std::string jsonText{JSON_Generator{shape, 42}.generate(16 * 1024)};
+    REQUIRE(JSON_Generator{shape, 42}.generate(16 * 1024) == jsonText);
+    REQUIRE(JSON_Generator{shape, 43}.generate(16 * 1024) != jsonText);
+  }
+  SECTION("Generate a document larger than a chunk to a file and check it "
+          "matches one generated to a buffer.",
+          "[JSON][Generator][File]") {
+    const std::string fileName{prefixTestDataPath("generated_corpus.json")};
+    const std::uint64_t size{3 * JSON_Generator::kChunkSize};
+    REQUIRE(JSON_Generator{shape}.generate(size, FileDestination{fileName}) ==
+            JSON_Generator{shape}.generate(size).size());
+    REQUIRE(readFromFile(fileName) == JSON_Generator{shape}.generate(size));
+    std::filesystem::remove(fileName);
+  }
+  SECTION("Check shape names.", "[JSON][Generator][Names]") {
+    REQUIRE(JSON_Generator::shape(JSON_Generator::name(shape)) == shape);
+    REQUIRE_THROWS_WITH(JSON_Generator::shape("twitter"),
+                        "JSON Generator Error: Unknown shape 'twitter'.");
+  }
+}
@@ -9,6 +9,9 @@
 // Test definitions
 // =================
 #include "JSONLib_Tests.hpp"
+#include "JSON_Generator.hpp"
+#include "JSON_Writer.hpp"
+#include <cstring>
 // ======================
 // JSON library namespace
 // ======================
@@ -56,6 +59,35 @@ TEST_CASE("IDestination (Buffer) interface.",
     REQUIRE(buffer.getBuffer().size() == 5);
     REQUIRE(buffer.getBuffer() == ("65767"));
   }
+  SECTION("Create BufferDestination with a capacity, append to it and then "
+          "move the result out.",
+          "[JSON][IDestination][Buffer]") {
+    BufferDestination buffer{1024};
+    REQUIRE(buffer.capacity() >= 1024);
+    buffer.append(std::string_view{"[1,2,"});
+    buffer.append("3]xxx", 2);
+    buffer.add('!');
+    REQUIRE(buffer.size() == 8);
+    const std::string result{buffer.release()};
+    REQUIRE(result == "[1,2,3]!");
+    REQUIRE(buffer.size() == 0);
+    buffer.add("65767");
+    REQUIRE(std::move(buffer).getBuffer() == "65767");
+  }
+  SECTION("Get the buffer through a const reference and check it holds only "
+          "the bytes added as more are added.",
+          "[JSON][IDestination][Buffer][Const]") {
+    BufferDestination buffer{1024};
+    const BufferDestination &constBuffer{buffer};
+    const std::string &contents{constBuffer.getBuffer()};
+    buffer.add("[1,");
+    REQUIRE(contents == "[1,");
+    auto space = buffer.prepare(64);
+    std::memcpy(space.data(), "2]", 2);
+    buffer.commit(2);
+    REQUIRE(contents == "[1,2]");
+    REQUIRE(contents.size() == constBuffer.size());
+  }
 }
 // ====
 // File
@@ -85,6 +117,7 @@ TEST_CASE("IDestination (File) interface.", "[JSON][IDestination][File]") {
     FileDestination file{testFileName};
     std::filesystem::path filePath{testFileName};
     file.add('t');
+    file.flush();
     REQUIRE(std::filesystem::file_size(filePath) == 1);
   }
   SECTION(
@@ -94,6 +127,7 @@ TEST_CASE("IDestination (File) interface.", "[JSON][IDestination][File]") {
     FileDestination file{testFileName};
     std::filesystem::path filePath{testFileName};
     file.add("65767");
+    file.flush();
     REQUIRE(std::filesystem::file_size(filePath) == 5);
     REQUIRE(readFromFile(testFileName) == "65767");
   }
@@ -105,11 +139,165 @@ TEST_CASE("IDestination (File) interface.", "[JSON][IDestination][File]") {
     FileDestination file{testFileName};
     std::filesystem::path filePath{testFileName};
     file.add("65767");
+    file.flush();
     REQUIRE(std::filesystem::file_size(filePath) == 5);
     REQUIRE(readFromFile(testFileName) == ("65767"));
     file.clear();
     file.add("65767");
+    file.flush();
     REQUIRE(std::filesystem::file_size(filePath) == 5);
     REQUIRE(readFromFile(testFileName) == ("65767"));
   }
+  SECTION("Create FileDestination and check nothing is written until the "
+          "buffer fills or it is flushed.",
+          "[JSON][IDestination][File]") {
+    std::filesystem::remove(testFileName);
+    std::filesystem::path filePath{testFileName};
+    {
+      FileDestination file{testFileName, 8};
+      file.add("1234");
+      file.add('5');
+      REQUIRE(std::filesystem::file_size(filePath) == 0);
+      file.add("6789");
+      REQUIRE(std::filesystem::file_size(filePath) == 5);
+      file.add("A string longer than the buffer.");
+      REQUIRE(std::filesystem::file_size(filePath) == 41);
+      file.add('!');
+    }
+    REQUIRE(readFromFile(testFileName) ==
+            "123456789A string longer than the buffer.!");
+  }
+#if defined(__linux__)
+  SECTION("Create FileDestination on a full device and check write errors "
+          "are reported.",
+          "[JSON][IDestination][File][Error]") {
+    FileDestination file{"/dev/full", 8};
+    file.add("1234");
+    REQUIRE_THROWS_WITH(
+        file.add("56789"),
+        "IDestination Error: File output stream failed to write to file.");
+    REQUIRE_THROWS_AS(file.flush(), IDestination::Error);
+    const JSON json;
+    json.parse(BufferSource{R"({"one":[1,2,3],"two":"2"})"});
+    REQUIRE_THROWS_AS(json.stringify(FileDestination{"/dev/full"}),
+                      IDestination::Error);
+  }
+#endif
+}
+// ==================================
+// Zero copy prepare()/commit() writes
+// ==================================
+TEST_CASE("IDestination prepare/commit interface.",
+          "[JSON][IDestination][Prepare]") {
+  SECTION("Prepare and commit into a BufferDestination.",
+          "[JSON][IDestination][Prepare][Buffer]") {
+    BufferDestination buffer;
+    buffer.add("[");
+    auto space = buffer.prepare(16);
+    REQUIRE(space.size() == 16);
+    std::memcpy(space.data(), "12345", 5);
+    buffer.commit(5);
+    buffer.add(']');
+    REQUIRE(buffer.getBuffer() == "[12345]");
+  }
+  SECTION("Stringify a large string into a BufferDestination and check the "
+          "buffer is not grown past the stringified size.",
+          "[JSON][IDestination][Prepare][Capacity]") {
+    const JSON json;
+    json.parse(BufferSource{R"({"a":")" + std::string(1000000, 'x') + R"("})"});
+    BufferDestination buffer;
+    json.stringify(buffer);
+    REQUIRE(buffer.size() == 1000008);
+    REQUIRE(buffer.capacity() < buffer.size() + 64);
+    BufferDestination written;
+    JSONWriter writer{written};
+    writer.value(std::string(1000000, 'x'));
+    REQUIRE(written.size() == 1000002);
+    REQUIRE(written.capacity() < written.size() + 64);
+  }
+  SECTION("Prepare and commit into a FileDestination both within and larger "
+          "than its write buffer.",
+          "[JSON][IDestination][Prepare][File]") {
+    const std::string testFileName{prefixTestDataPath(kGeneratedJSONFile)};
+    std::filesystem::remove(testFileName);
+    {
+      FileDestination file{testFileName, 8};
+      file.add("abc");
+      auto space = file.prepare(6);
+      std::memcpy(space.data(), "defghi", 6);
+      file.commit(3);
+      space = file.prepare(20);
+      std::memcpy(space.data(), "0123456789", 10);
+      file.commit(10);
+      file.add('!');
+    }
+    REQUIRE(readFromFile(testFileName) == "abcdef0123456789!");
+  }
+  SECTION("Prepare and commit into a destination using the default scratch "
+          "buffer implementation.",
+          "[JSON][IDestination][Prepare][Default]") {
+    class StringDestination : public IDestination {
+    public:
+      void add(const std::string &bytes) override { result += bytes; }
+      void add(const char ch) override { result += ch; }
+      void clear() override { result.clear(); }
+      std::string result;
+    };
+    StringDestination destination;
+    auto space = destination.prepare(4);
+    std::memcpy(space.data(), "true", 4);
+    destination.commit(4);
+    REQUIRE(destination.result == "true");
+    const JSON json;
+    json.parse(BufferSource{R"({"one":[1,2.5,"\t\u00e9"]})"});
+    json.stringify(destination);
+    REQUIRE(destination.result == R"(true{"one":[1,2.5,"\t\u00E9"]})");
+  }
+}
+
+// ===========================
+// Gather add() of several runs
+// ===========================
+TEST_CASE("IDestination gather interface.", "[JSON][IDestination][Gather]") {
+  const std::vector<std::string_view> runs{"[", "1,2", ",", "", "3]"};
+  SECTION("Gather runs into a BufferDestination and check it grows once.",
+          "[JSON][IDestination][Gather][Buffer]") {
+    BufferDestination buffer;
+    buffer.add('!');
+    IDestination &destination{buffer};
+    destination.add(std::span<const std::string_view>{runs});
+    REQUIRE(buffer.getBuffer() == "![1,2,3]");
+    REQUIRE(buffer.capacity() < buffer.size() + 64);
+  }
+  SECTION("Gather runs both within and larger than the write buffer into a "
+          "FileDestination.",
+          "[JSON][IDestination][Gather][File]") {
+    const std::string testFileName{prefixTestDataPath(kGeneratedJSONFile)};
+    std::filesystem::remove(testFileName);
+    const std::string large(64, 'x');
+    {
+      FileDestination file{testFileName, 8};
+      IDestination &destination{file};
+      destination.add(std::span<const std::string_view>{runs});
+      const std::vector<std::string_view> more{"\"", large, "\""};
+      destination.add(std::span<const std::string_view>{more});
+    }
+    REQUIRE(readFromFile(testFileName) == "[1,2,3]\"" + large + "\"");
+  }
+  SECTION("Stringify in parallel into buffer and file and compare with a "
+          "serial stringify.",
+          "[JSON][IDestination][Gather][Parallel]") {
+    const std::string testFileName{prefixTestDataPath(kGeneratedJSONFile)};
+    const JSON json;
+    json.parse(BufferSource{JSON_Generator{JSON_Generator::Shape::records}
+                                .generate(256 * 1024)});
+    BufferDestination serial;
+    json.stringify(serial);
+    BufferDestination parallel;
+    json.stringifyParallel(parallel);
+    REQUIRE(parallel.getBuffer() == serial.getBuffer());
+    json.stringifyParallel(FileDestination{testFileName});
+    REQUIRE(readFromFile(testFileName) == serial.getBuffer());
+    std::filesystem::remove(testFileName);
+  }
 }
@@ -143,6 +143,18 @@ TEST_CASE("ISource (Buffer) interface (uses file testfile001.json).",
     REQUIRE_THROWS_WITH(source.next(),
                         "ISource Error: Tried to read past and of buffer.");
   }
+  SECTION("Check that BufferSource exposes its buffer and skips through it.",
+          "[JSON][ISource][Buffer]") {
+    BufferSource source{"[1,2,3]"};
+    REQUIRE(source.buffered() == "[1,2,3]");
+    source.skip(2);
+    REQUIRE(source.current() == ',');
+    REQUIRE(source.buffered() == ",2,3]");
+    source.skip(5);
+    REQUIRE_FALSE(source.more());
+    REQUIRE(source.buffered().empty());
+    REQUIRE_THROWS_AS(source.skip(1), ISource::Error);
+  }
 }
 // ====
 // File
@@ -285,4 +297,11 @@ TEST_CASE("ISource (File) interface.", "[JSON][ISource][File]") {
     REQUIRE_THROWS_WITH(source.next(),
                         "ISource Error: Tried to read past end of file.");
   }
+  SECTION("Check that FileSource does not expose a buffer but still skips.",
+          "[JSON][ISource][File]") {
+    FileSource source{testFileName};
+    REQUIRE(source.buffered().empty());
+    source.skip(1);
+    REQUIRE(source.position() == 1);
+  }
 }
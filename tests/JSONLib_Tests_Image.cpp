@@ -0,0 +1,175 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON image (memory mappable immutable document) unit
+// tests using the Catch2 test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Image.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ===============
+// Local functions
+// ===============
+/// <summary>
+/// Recursively compare a JNode tree against an image view.
+/// </summary>
+/// <param name="jNode">JNode to compare.</param>
+/// <param name="view">Image view to compare.</param>
+/// <returns>==true then the same.</returns>
+static bool compareImage(const JNode &jNode, const JSON_Image::View &view) {
+  if (jNode.getNodeType() != view.getNodeType()) {
+    return (false);
+  }
+  switch (jNode.getNodeType()) {
+  case JNodeType::object: {
+    if (static_cast<std::size_t>(JNodeRef<JNodeObject>(jNode).size()) !=
+        view.size()) {
+      return (false);
+    }
+    auto entry = view.begin();
+    for (auto &[key, jNodePtr] : JNodeRef<JNodeObject>(jNode).objects()) {
+      if (entry.key() != key || !compareImage(*jNodePtr, *entry) ||
+          !compareImage(*jNodePtr, view[key])) {
+        return (false);
+      }
+      ++entry;
+    }
+    return (entry == view.end());
+  }
+  case JNodeType::array: {
+    if (JNodeRef<JNodeArray>(jNode).size() != view.size()) {
+      return (false);
+    }
+    const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+    if (jNodeArray.packing() != JNodeArray::Packing::none) {
+      for (std::size_t index = 0; index < jNodeArray.size(); index++) {
+        if (view[index].getNodeType() != JNodeType::number ||
+            !equalFloatingPoint(jNodeArray.numeric(index).getDouble(),
+                                view[index].getDouble(), 0.0001)) {
+          return (false);
+        }
+      }
+      return (true);
+    }
+    std::size_t index{};
+    for (auto &jNodePtr : jNodeArray.array()) {
+      if (!compareImage(*jNodePtr, view[index++])) {
+        return (false);
+      }
+    }
+    return (true);
+  }
+  case JNodeType::string:
+    return (JNodeRef<JNodeString>(jNode).string() == view.string());
+  case JNodeType::number:
+    return (equalFloatingPoint(
+        JNodeRef<JNodeNumber>(jNode).number().getDouble(), view.getDouble(),
+        0.0001));
+  case JNodeType::boolean:
+    return (JNodeRef<JNodeBoolean>(jNode).boolean() == view.boolean());
+  default:
+    return (true);
+  }
+}
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Write JSON images and query them in place through views.",
+          "[JSON][Image]") {
+  const JSON json;
+  SECTION("Write image of object and access entries by key.",
+          "[JSON][Image][Object]") {
+    json.parse(BufferSource{R"({"Population":500000,"City":"Southampton",)"
+                            R"("Info":{"b":[1,2.5,true,false,null],"a":"x"}})"});
+    BufferDestination destination;
+    JSON_Image::write(json.root(), destination);
+    REQUIRE(destination.getBuffer().size() % JSON_Image::kWordSize == 0);
+    const auto image = JSON_Image::fromMemory(destination.getBuffer());
+    const auto root = image.root();
+    REQUIRE(root.getNodeType() == JNodeType::object);
+    REQUIRE(root.size() == 3);
+    REQUIRE(root.contains("City"));
+    REQUIRE_FALSE(root.contains("Town"));
+    REQUIRE(root["City"].string() == "Southampton");
+    REQUIRE(root["Population"].isLLong());
+    REQUIRE(root["Population"].getLLong() == 500000);
+    REQUIRE(root["Info"]["a"].string() == "x");
+    REQUIRE(root["Info"]["b"][1].getDouble() == 2.5);
+    REQUIRE(root["Info"]["b"][2].boolean());
+    REQUIRE_FALSE(root["Info"]["b"][3].boolean());
+    REQUIRE(root["Info"]["b"][4].getNodeType() == JNodeType::null);
+    REQUIRE((*root.begin()).getLLong() == 500000);
+    REQUIRE(root.begin().key() == "Population");
+    REQUIRE_THROWS_WITH(root["Town"],
+                        "JNode Error: Invalid key used to access object.");
+    REQUIRE_THROWS_WITH(root["Info"]["b"][5],
+                        "JNode Error: Invalid index used to access array.");
+  }
+  SECTION("Write image of decimal fractions and check they read back exactly.",
+          "[JSON][Image][Decimals]") {
+    const std::vector<std::string> decimals{"0.1", "0.2", "123.456",
+                                            "-65.61362", "0.001", "3.4e+38"};
+    std::string jsonText{"["};
+    for (const auto &decimal : decimals) {
+      jsonText += decimal + ",";
+    }
+    jsonText += R"({"a":0.1}])";
+    json.parse(BufferSource{jsonText});
+    BufferDestination destination;
+    JSON_Image::write(json.root(), destination);
+    const auto image = JSON_Image::fromMemory(destination.getBuffer());
+    for (std::size_t index = 0; index < decimals.size(); index++) {
+      REQUIRE(image.root()[index].getDouble() ==
+              std::strtod(decimals[index].c_str(), nullptr));
+    }
+    REQUIRE(image.root()[decimals.size()]["a"].getDouble() == 0.1);
+    BufferDestination stringified;
+    json.stringify(stringified);
+    REQUIRE(stringified.getBuffer() == jsonText);
+    json.parse(BufferSource{"[0.1,0.2,123.456]"});
+    destination.clear();
+    JSON_Image::write(json.root(), destination);
+    const auto packed = JSON_Image::fromMemory(destination.getBuffer());
+    REQUIRE(packed.root()[0].getDouble() == 0.1);
+    REQUIRE(packed.root()[2].getDouble() == 123.456);
+  }
+  SECTION("Write test files to image files, map them and check against "
+          "JNode tree.",
+          "[JSON][Image][Files]") {
+    TEST_FILE_LIST(testFile);
+    const std::string imageFileName{
+        prefixTestDataPath(testFile + ".image")};
+    json.parse(FileSource{prefixTestDataPath(testFile)});
+    JSON_Image::write(json.root(), FileDestination{imageFileName});
+    {
+      const auto image = JSON_Image::open(imageFileName);
+      REQUIRE(compareImage(json.root(), image.root()));
+    }
+    std::filesystem::remove(imageFileName);
+  }
+  SECTION("Open invalid images and check exceptions.",
+          "[JSON][Image][Exceptions]") {
+    json.parse(BufferSource{R"(["one","two"])"});
+    BufferDestination destination;
+    JSON_Image::write(json.root(), destination);
+    const std::string_view image{destination.getBuffer()};
+    REQUIRE_THROWS_WITH(JSON_Image::fromMemory(image.substr(8)),
+                        "JSON Image Error: Invalid image.");
+    REQUIRE_THROWS_WITH(
+        JSON_Image::fromMemory(image.substr(0, image.size() - 4)),
+        "JSON Image Error: Invalid image.");
+    std::string corrupt{image};
+    corrupt[corrupt.size() - 2] = 0x7f;
+    REQUIRE_THROWS_WITH(JSON_Image::fromMemory(corrupt).root().size(),
+                        "JSON Image Error: Invalid offset.");
+    REQUIRE_THROWS_WITH(JSON_Image::open("missing.image"),
+                        "JSON Image Error: Image file failed to open or does "
+                        "not exist.");
+  }
+}
@@ -100,4 +100,46 @@ TEST_CASE("Check JNode reference functions work.", "[JSON][JNode][Reference]") {
     REQUIRE(JNodeRef<JNodeString>((json.root())["City"]).string() ==
             "Southampton");
   }
-}
\ No newline at end of file
+}
+// =====================
+// JNode inline variants
+// =====================
+TEST_CASE("Check JNode holds its variant inline.", "[JSON][JNode][Variant]") {
+  SECTION("Construct JNode directly from a variant and check its type.",
+          "[JSON][JNode][Variant]") {
+    JNode jNode{JNodeString{"inline"}};
+    REQUIRE(jNode.getNodeType() == JNodeType::string);
+    REQUIRE(JNodeRef<JNodeString>(jNode).string() == "inline");
+  }
+  SECTION("Change a JNode type in place and check references to it still valid.",
+          "[JSON][JNode][Variant]") {
+    JSON json;
+    json["root"] = "string";
+    JNode &jNode = json["root"];
+    jNode = 42;
+    REQUIRE(&jNode == &json["root"]);
+    REQUIRE(jNode.getNodeType() == JNodeType::number);
+    jNode = nullptr;
+    REQUIRE(jNode.getNodeType() == JNodeType::null);
+    jNode = true;
+    REQUIRE(JNodeRef<JNodeBoolean>(jNode).boolean());
+  }
+  SECTION("Check each node type matches its variant.",
+          "[JSON][JNode][Variant]") {
+    BufferSource jsonSource{"[{},[],1,\"2\",true,null]"};
+    const JSON json;
+    json.parse(jsonSource);
+    REQUIRE(json[0].getNodeType() == JNodeType::object);
+    REQUIRE(json[1].getNodeType() == JNodeType::array);
+    REQUIRE(json[2].getNodeType() == JNodeType::number);
+    REQUIRE(json[3].getNodeType() == JNodeType::string);
+    REQUIRE(json[4].getNodeType() == JNodeType::boolean);
+    REQUIRE(json[5].getNodeType() == JNodeType::null);
+    REQUIRE(JNodeRef<JNodeObject>(json[0]).getNodeType() ==
+            json[0].getNodeType());
+    REQUIRE(JNodeRef<JNodeNull>(json[5]).getNodeType() ==
+            json[5].getNodeType());
+    // The type is the variant index so the base variant holds no tag
+    REQUIRE(std::is_empty_v<JNodeVariant>);
+  }
+}
@@ -145,7 +145,7 @@ TEST_CASE("Check JNodeNumeric api for all supported number types.",
   JSON json;
   SECTION("Check numbers are the correct type.",
           "[JSON][JNode][JNodeNumeric][Addition]") {
-    json["root"] = {1, 1l, 1ll, 1.0f, 1.0, 1.0L};
+    json["root"] = JNode{1, 1l, 1ll, 1.0f, 1.0, 1.0L};
     BufferDestination destinationBuffer;
     json.stringify(destinationBuffer);
     REQUIRE(destinationBuffer.getBuffer() == R"({"root":[1,1,1,1.0,1.0,1.0]})");
@@ -158,7 +158,7 @@ TEST_CASE("Check JNodeNumeric api for all supported number types.",
   }
   SECTION("Simple arithmetic add one to a number",
           "[JSON][JNode][JNodeNumeric][Get/Set]") {
-    json["root"] = {1, 1l, 1ll, 1.0f, 1.0, 1.0L};
+    json["root"] = JNode{1, 1l, 1ll, 1.0f, 1.0, 1.0L};
     BufferDestination destinationBuffer;
     json.stringify(destinationBuffer);
     REQUIRE(destinationBuffer.getBuffer() == R"({"root":[1,1,1,1.0,1.0,1.0]})");
@@ -202,7 +202,7 @@ TEST_CASE("Check JNodeNumeric api for all supported number types.",
     REQUIRE(destinationBuffer.getBuffer() == R"({"root":[2,2,2,2.0,2.0,2.0]})");
   }
   SECTION("Change types and values.", "[JSON][JNode][JNodeNumeric][Reset]") {
-    json["root"] = {1, 1l, 1ll, 1.0f, 1.0, 1.0L};
+    json["root"] = JNode{1, 1l, 1ll, 1.0f, 1.0, 1.0L};
     BufferDestination destinationBuffer;
     json.stringify(destinationBuffer);
     REQUIRE(destinationBuffer.getBuffer() == R"({"root":[1,1,1,1.0,1.0,1.0]})");
@@ -226,4 +226,50 @@ TEST_CASE("Check JNodeNumeric api for all supported number types.",
     REQUIRE(destinationBuffer.getBuffer() ==
             R"({"root":[1,1,3.0,1.0,1.0,445]})");
   }
-}
\ No newline at end of file
+  SECTION("Check floating point is stringified in its shortest form that "
+          "reads back to the same value.",
+          "[JSON][JNode][JNodeNumeric][Format]") {
+    REQUIRE(JNodeNumeric{0.1}.getString() == "0.1");
+    REQUIRE(JNodeNumeric{3.14159265358979}.getString() == "3.14159265358979");
+    REQUIRE(JNodeNumeric{1e22}.getString() == "1e+22");
+    REQUIRE(JNodeNumeric{-2.5e-8}.getString() == "-2.5e-08");
+    REQUIRE(JNodeNumeric{100.0}.getString() == "100.0");
+    REQUIRE(JNodeNumeric{1.5f}.getString() == "1.5");
+    REQUIRE(JNodeNumeric{-9223372036854775807ll}.getString() ==
+            "-9223372036854775807");
+    const double value{0.30000000000000004};
+    REQUIRE(std::stod(JNodeNumeric{value}.getString()) == value);
+    for (const double number : {1.0 / 3.0, 2.0 / 3.0, 1e300, 5e-324}) {
+      const JNodeNumeric numeric{number};
+      std::array<char, JNodeNumeric::kMaxCharacters> buffer{};
+      char *end =
+          numeric.toChars(buffer.data(), buffer.data() + buffer.size());
+      REQUIRE(static_cast<std::size_t>(end - buffer.data()) <=
+              numeric.maxCharacters());
+      REQUIRE(std::strtod(buffer.data(), nullptr) == number);
+    }
+  }
+  SECTION("Check numeric is compact and long double is held out of line.",
+          "[JSON][JNode][JNodeNumeric][Compact]") {
+    REQUIRE(sizeof(JNodeNumeric) <= 2 * sizeof(double));
+    REQUIRE(JNodeNumeric{1.5}.allocatedBytes() == 0);
+    JNodeNumeric numeric{2.5L};
+    REQUIRE(numeric.allocatedBytes() == sizeof(long double));
+    JNodeNumeric copy{numeric};
+    REQUIRE(copy.isLDouble());
+    REQUIRE_FALSE(!numeric.setLDouble(3.5L));
+    REQUIRE(copy.getLDouble() == 2.5L);
+    REQUIRE(numeric.getLDouble() == 3.5L);
+    copy = numeric;
+    REQUIRE(copy.getLDouble() == 3.5L);
+    JNodeNumeric moved{std::move(copy)};
+    REQUIRE(moved.getLDouble() == 3.5L);
+    REQUIRE_FALSE(!numeric.setInt(7));
+    REQUIRE(numeric.allocatedBytes() == 0);
+    REQUIRE(numeric.getInt() == 7);
+    REQUIRE_FALSE(!numeric.setLDouble("1e400"));
+    REQUIRE(numeric.isLDouble());
+    numeric = JNodeNumeric{1};
+    REQUIRE(numeric.isInt());
+  }
+}
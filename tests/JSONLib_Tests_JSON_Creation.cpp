@@ -325,7 +325,7 @@ TEST_CASE("JSON create complex JSON structures", "[JSON][Create][Complex]") {
     json["name"] = "Niels";
     json["nothing"] = nullptr;
     json["answer"]["everything"] = 42;
-    json["list"] = {1, 0, 2};
+    json["list"] = JNode{1, 0, 2};
     json["object"] = {{"currency", "USD"}, {"value", 42.99}};
     BufferDestination jsonDestination;
     REQUIRE_NOTHROW(json.stringify(jsonDestination));
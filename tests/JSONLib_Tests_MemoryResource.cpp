@@ -0,0 +1,186 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON polymorphic memory resource unit tests using the
+// Catch2 test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_ByteCountingResource.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Use a custom memory resource for JNode tree allocation.",
+          "[JSON][MemoryResource]") {
+  CountingResource resource;
+  SECTION("Parse a file and check all allocations come from resource and "
+          "are returned on destruction.",
+          "[JSON][MemoryResource][Parse]") {
+    TEST_FILE_LIST(testFile);
+    {
+      const JSON json(nullptr, nullptr, &resource);
+      json.parse(FileSource{prefixTestDataPath(testFile)});
+      REQUIRE(resource.allocations > 0);
+      REQUIRE(resource.bytesOutstanding > 0);
+      BufferDestination jsonDestination;
+      json.stringify(jsonDestination);
+      REQUIRE(jsonDestination.getBuffer() ==
+              stripWhiteSpace(json, readFromFile(prefixTestDataPath(testFile))));
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Build a tree with the index operators and check allocations come "
+          "from resource.",
+          "[JSON][MemoryResource][Creation]") {
+    {
+      JSON json(nullptr, nullptr, &resource);
+      json["pi"] = 3.141;
+      json["name"]["first"] = "A string that is too long for small string "
+                              "optimisation to apply.";
+      json["list"][3] = "Another string that will need to be allocated.";
+      REQUIRE(JNodeRef<JNodeObject>(json.root())
+                  .objects()
+                  .get_allocator()
+                  .resource() == &resource);
+      REQUIRE(json["name"].getMemoryResource() == &resource);
+      REQUIRE(json["name"]["first"].getMemoryResource() == &resource);
+      REQUIRE(json["list"].getMemoryResource() == &resource);
+      REQUIRE(json["list"][3].getMemoryResource() == &resource);
+      BufferDestination jsonDestination;
+      json.stringify(jsonDestination);
+      REQUIRE(jsonDestination.getBuffer() ==
+              R"({"pi":3.141,"name":{"first":"A string that is too long for )"
+              R"(small string optimisation to apply."},"list":[null,null,)"
+              R"(null,"Another string that will need to be allocated."]})");
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Assign values to parsed nodes and check they keep the resource.",
+          "[JSON][MemoryResource][Assignment]") {
+    {
+      JSON json(nullptr, nullptr, &resource);
+      json.parse(BufferSource{R"({"a":"text","b":[1,true,null]})"});
+      json["a"] = 42;
+      REQUIRE(json["a"].getMemoryResource() == &resource);
+      json["a"] = "A string that is too long for small string optimisation";
+      REQUIRE(json["a"].getMemoryResource() == &resource);
+      json["b"][1] = nullptr;
+      json["b"][2] = false;
+      REQUIRE(json["b"][1].getMemoryResource() == &resource);
+      REQUIRE(json["b"][2].getMemoryResource() == &resource);
+      json["c"] = JNode({1, "two", 3.0}, json.root().getMemoryResource());
+      json["d"] = JNode({{"key", "value"}}, json.root().getMemoryResource());
+      REQUIRE(json["c"][1].getMemoryResource() == &resource);
+      REQUIRE(json["d"]["key"].getMemoryResource() == &resource);
+      REQUIRE(json.memoryUsage().total() == resource.bytesOutstanding);
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Parse test files and check memory usage matches the bytes "
+          "allocated from the resource.",
+          "[JSON][MemoryResource][Usage]") {
+    TEST_FILE_LIST(testFile);
+    const JSON json(nullptr, nullptr, &resource);
+    REQUIRE(json.memoryUsage().total() == 0);
+    json.parse(FileSource{prefixTestDataPath(testFile)});
+    const auto usage = json.memoryUsage();
+    REQUIRE(usage.total() == resource.bytesOutstanding);
+    REQUIRE(usage.nodeBytes == usage.nodes * sizeof(JNode));
+    REQUIRE(usage.containerUnusedBytes <= usage.containerBytes);
+  }
+  SECTION("Parse test files and check the bytes held are those counted by "
+          "the resource.",
+          "[JSON][MemoryResource][Counted]") {
+    TEST_FILE_LIST(testFile);
+    ByteCountingResource counting;
+    {
+      const JSON json(nullptr, nullptr, &counting);
+      json.parse(FileSource{prefixTestDataPath(testFile)});
+      const auto usage = json.memoryUsage();
+      REQUIRE(usage.allocatedBytes == counting.outstanding());
+      REQUIRE(usage.allocatedBytes == usage.total());
+    }
+    REQUIRE(counting.outstanding() == 0);
+    REQUIRE(counting.allocated() > 0);
+  }
+  SECTION("Build a tree with long doubles and check they are allocated from "
+          "the resource.",
+          "[JSON][MemoryResource][LongDouble]") {
+    {
+      JSON json(nullptr, nullptr, &resource);
+      json.parse(BufferSource{"[1,2,3]"});
+      json[0] = 1.5L;
+      REQUIRE(JNodeRef<JNodeNumber>(json[0]).number().isLDouble());
+      REQUIRE_FALSE(
+          !JNodeRef<JNodeNumber>(json[1]).number().setLDouble(2.5L));
+      json[2] = JNode{{3.5L}, json.root().getMemoryResource()};
+      const auto usage = json.memoryUsage();
+      REQUIRE(usage.numberBytes == 3 * sizeof(long double));
+      REQUIRE(usage.total() == resource.bytesOutstanding);
+      REQUIRE(json[1].getMemoryResource() == &resource);
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Build a tree and check long keys/strings are accounted for.",
+          "[JSON][MemoryResource][UsageBreakdown]") {
+    JSON json(nullptr, nullptr, &resource);
+    const std::string longText(100, 'x');
+    json[longText] = longText;
+    json["short"] = "x";
+    const auto usage = json.memoryUsage();
+    REQUIRE(usage.nodes == 3);
+    REQUIRE(usage.keyBytes == 101);
+    REQUIRE(usage.stringBytes == 101);
+    REQUIRE(usage.total() == resource.bytesOutstanding);
+  }
+  SECTION("Check packed array memory usage matches its resource.",
+          "[JSON][MemoryResource][Packed]") {
+    const JSON counted(nullptr, nullptr, &resource);
+    counted.parse(BufferSource{"[[1,2,3],[4.5,5.5],[6]]"});
+    REQUIRE(counted.memoryUsage().total() == resource.bytesOutstanding);
+    const JNode &root = counted.root();
+    REQUIRE(JNodeRef<JNodeArray>(root[1]).numeric(1).isFloat());
+    REQUIRE(counted.memoryUsage().total() == resource.bytesOutstanding);
+    REQUIRE(counted.memoryUsage().nodes == 4);
+    JSON &modifiable = const_cast<JSON &>(counted);
+    REQUIRE(JNodeRef<JNodeNumber>(modifiable[1][0]).number().isFloat());
+    REQUIRE(JNodeRef<JNodeArray>(root[1]).packing() ==
+            JNodeArray::Packing::none);
+    REQUIRE(modifiable[1][0].getMemoryResource() == &resource);
+    REQUIRE(counted.memoryUsage().total() == resource.bytesOutstanding);
+    REQUIRE(counted.memoryUsage().nodes == 4 + 2);
+  }
+  SECTION("Move a packed array into a tree using another resource.",
+          "[JSON][MemoryResource][PackedMove]") {
+    std::pmr::monotonic_buffer_resource monotonic;
+    {
+      JSON plain(nullptr, nullptr, &resource);
+      {
+        JSON packed(nullptr, nullptr, &monotonic);
+        packed.parse(BufferSource{"[1,2,3,4,5,6,7,8,9,10]"});
+        plain["a"] = JNode{{1, 2}, &resource};
+        plain["a"] = std::move(packed.root());
+      }
+      REQUIRE(JNodeRef<JNodeArray>(plain["a"]).packing() ==
+              JNodeArray::Packing::integer);
+      REQUIRE(plain.memoryUsage().total() == resource.bytesOutstanding);
+      BufferDestination destination;
+      plain.stringify(destination);
+      REQUIRE(destination.getBuffer() == R"({"a":[1,2,3,4,5,6,7,8,9,10]})");
+    }
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Parse into a monotonic buffer resource.",
+          "[JSON][MemoryResource][Monotonic]") {
+    std::pmr::monotonic_buffer_resource monotonic{&resource};
+    const JSON json(nullptr, nullptr, &monotonic);
+    json.parse(BufferSource{R"({"City":"Southampton","Population":500000})"});
+    checkObject(json.root());
+  }
+}
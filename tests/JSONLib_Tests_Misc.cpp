@@ -8,6 +8,9 @@
 // Test definitions
 // =================
 #include "JSONLib_Tests.hpp"
+#include "JSON_Minifier.hpp"
+#include <atomic>
+#include <thread>
 // ======================
 // JSON library namespace
 // ======================
@@ -119,6 +122,50 @@ TEST_CASE("Check whitespace stripping with escape characters.",
     REQUIRE(jsonDestination.getBuffer() == readFromFile(generatedFileName));
   }
 }
+TEST_CASE("Check block based whitespace stripping.", "[JSON][Strip][Block]") {
+  const JSON json;
+  SECTION("Find special characters and check against a simple scan.",
+          "[JSON][Strip][Block]") {
+    const std::string text{"abcdefghijklmnopqrstuvwxyz0123456789 \t\n\r\"\\"};
+    for (std::size_t start = 0; start < text.size(); start++) {
+      for (const bool inString : {false, true}) {
+        const char *expected = text.data() + start;
+        while (expected != text.data() + text.size() &&
+               !(inString ? (*expected == '"' || *expected == '\\')
+                          : (*expected == ' ' || *expected == '\t' ||
+                             *expected == '\n' || *expected == '\r' ||
+                             *expected == '"'))) {
+          expected++;
+        }
+        REQUIRE(JSON_Minifier::findSpecial(text.data() + start,
+                                           text.data() + text.size(),
+                                           inString) == expected);
+      }
+    }
+  }
+  SECTION("Strip JSON larger than a block with strings and escapes spanning "
+          "block boundaries.",
+          "[JSON][Strip][Block]") {
+    std::string jsonString{"[\n"};
+    std::string expected{"["};
+    while (jsonString.size() < 3 * JSON_Minifier::kBlockSize) {
+      jsonString += "  \"a string with \\\" \\p spaces\" ,\t\r\n";
+      expected += "\"a string with \\\" p spaces\",";
+    }
+    jsonString += "  1 ]  ";
+    expected += "1]";
+    BufferDestination strippedDestination;
+    json.strip(BufferSource{jsonString}, strippedDestination);
+    REQUIRE(strippedDestination.getBuffer() == expected);
+  }
+  SECTION("Strip JSON with an unterminated string and check exception.",
+          "[JSON][Strip][Block]") {
+    BufferDestination strippedDestination;
+    REQUIRE_THROWS_WITH(
+        json.strip(BufferSource{R"([ "unterminated ])"}, strippedDestination),
+        "JSON Error: Syntax error detected.");
+  }
+}
 // =====================
 // Strip JSON Whitespace
 // =====================
@@ -151,3 +198,132 @@ TEST_CASE("Check white space stripping.", "[JSON][Parse][Strip]") {
     REQUIRE(jsonDestination.getBuffer() == readFromFile(generatedFileName));
   }
 }
+TEST_CASE("Check direct escaping matches the default translator.",
+          "[JSON][DefaultTranslator][Escape]") {
+  JSON_Converter converter;
+  JSON_Translator translator(converter);
+  SECTION("Escape strings directly into a buffer and compare with toJSON().",
+          "[JSON][DefaultTranslator][Escape]") {
+    const std::u8string unicode{u8"Caf\u00e9 \u20ac \U0001D11E"};
+    for (const std::string &string :
+         {std::string{"plain"}, std::string{"\t\n\r\b\f\"\\/"},
+          std::string{"\x01\x1f\x7f"}, std::string{""},
+          std::string{unicode.begin(), unicode.end()}}) {
+      std::string buffer(JSON_Translator::escapedSize(string), ' ');
+      char *end = JSON_Translator::escape(string, buffer.data());
+      REQUIRE(end == buffer.data() + buffer.size());
+      REQUIRE(std::string(buffer.data(), end) == translator.toJSON(string));
+    }
+  }
+  SECTION("Escape invalid UTF-8 and check it is rejected.",
+          "[JSON][DefaultTranslator][Escape]") {
+    std::array<char, 64> buffer{};
+    REQUIRE(JSON_Translator::escape("\xff", buffer.data()) == nullptr);
+    REQUIRE(JSON_Translator::escape("\xc3", buffer.data()) == nullptr);
+    REQUIRE(JSON_Translator::escape("\xc0\x80", buffer.data()) == nullptr);
+    REQUIRE(JSON_Translator::escape("\xed\xa0\x80", buffer.data()) ==
+            nullptr);
+  }
+}
+TEST_CASE("Check JSON objects can be used concurrently on separate threads.",
+          "[JSON][Concurrency]") {
+  SECTION("Parse and stringify escaped JSON on several threads at once while "
+          "other JSON objects are being constructed.",
+          "[JSON][Concurrency][Translator]") {
+    const std::string jsonString{
+        R"({"Escapes":"\t\n\r\b\f\"\\","Unicode":"\u0041\u00e9\ud834\udd1e"})"};
+    std::vector<std::thread> workers;
+    std::atomic<int> mismatches{};
+    for (int thread = 0; thread < 8; thread++) {
+      workers.emplace_back([&jsonString, &mismatches] {
+        for (int iteration = 0; iteration < 200; iteration++) {
+          const JSON json;
+          json.parse(BufferSource{jsonString});
+          BufferDestination jsonDestination;
+          json.stringify(jsonDestination);
+          if (jsonDestination.getBuffer() !=
+              R"({"Escapes":"\t\n\r\b\f\"\\","Unicode":"A\u00E9\uD834\uDD1E"})") {
+            mismatches++;
+          }
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    REQUIRE(mismatches == 0);
+  }
+}
+TEST_CASE("Check statistics gathered while parsing and stringifying.",
+          "[JSON][Misc][Statistics]") {
+  const JSON json;
+  SECTION("Parse JSON and check node counts, depth and escapes.",
+          "[JSON][Misc][Statistics][Parse]") {
+    const std::string jsonText{
+        R"({"a\tb":[1,3000000000,2.5,"x\n",true,null,{"c":[[]]}]})"};
+    json.parse(BufferSource{jsonText});
+    const auto &stats = json.stats();
+    if (!stats.enabled) {
+      REQUIRE(stats.objects == 0);
+      return;
+    }
+    REQUIRE(stats.bytesConsumed == jsonText.size());
+    REQUIRE(stats.objects == 2);
+    REQUIRE(stats.arrays == 3);
+    REQUIRE(stats.strings == 1);
+    REQUIRE(stats.numbers == 3);
+    REQUIRE(stats.numericFallbacks == 2);
+    REQUIRE(stats.booleans == 1);
+    REQUIRE(stats.nulls == 1);
+    REQUIRE(stats.maxDepth == 5);
+    REQUIRE(stats.escapedStrings == 2);
+    REQUIRE(stats.parseTime.count() > 0);
+    json.parse(BufferSource{"[1]"});
+    REQUIRE(json.stats().arrays == 4);
+    REQUIRE(json.stats().maxDepth == 5);
+    json.resetStats();
+    REQUIRE(json.stats().enabled);
+    REQUIRE(json.stats().arrays == 0);
+    REQUIRE(json.stats().parseTime.count() == 0);
+  }
+  SECTION("Stringify, strip and validate and check times and bytes.",
+          "[JSON][Misc][Statistics][Phases]") {
+    const std::string jsonText{R"( [ 1 , 2 , 3 ] )"};
+    json.parse(BufferSource{jsonText});
+    json.resetStats();
+    BufferDestination destination;
+    json.stringify(destination);
+    json.strip(BufferSource{jsonText}, BufferDestination{});
+    REQUIRE(json.validate(BufferSource{jsonText}));
+    if (json.stats().enabled) {
+      REQUIRE(json.stats().stringifyTime.count() > 0);
+      REQUIRE(json.stats().stripTime.count() > 0);
+      REQUIRE(json.stats().validateTime.count() > 0);
+      REQUIRE(json.stats().bytesConsumed == 2 * jsonText.size());
+      REQUIRE(json.stats().numbers == 0);
+    }
+  }
+  SECTION("Stringify on several threads at once and check times and bytes.",
+          "[JSON][Misc][Statistics][Threads]") {
+    const std::string jsonText{R"([1,"two",{"three":3.5}])"};
+    json.parse(BufferSource{jsonText});
+    json.resetStats();
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++) {
+      threads.emplace_back([&json, &jsonText] {
+        for (int repeat = 0; repeat < 100; repeat++) {
+          BufferDestination destination;
+          json.stringify(destination);
+          json.strip(BufferSource{jsonText}, destination);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (json.stats().enabled) {
+      REQUIRE(json.stats().stringifyTime.count() > 0);
+      REQUIRE(json.stats().bytesConsumed == 4 * 100 * jsonText.size());
+    }
+  }
+}
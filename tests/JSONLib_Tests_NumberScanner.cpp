@@ -0,0 +1,168 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON number scanner (SWAR digit conversion) unit tests
+// using the Catch2 test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Generator.hpp"
+#include "JSON_NumberScanner.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Check number scanner converts digits eight at a time.",
+          "[JSON][NumberScanner]") {
+  SECTION("Check eight digit words are recognised.",
+          "[JSON][NumberScanner][Digits]") {
+    REQUIRE(JSON_NumberScanner::isEightDigits(
+        JSON_NumberScanner::loadEight("01234567")));
+    REQUIRE(JSON_NumberScanner::isEightDigits(
+        JSON_NumberScanner::loadEight("99999999")));
+    for (const std::string text : {"0123456.", "/1234567", "1234567:",
+                                   "1234-567", "12345e67", "        "}) {
+      REQUIRE_FALSE(
+          JSON_NumberScanner::isEightDigits(JSON_NumberScanner::loadEight(
+              text.data())));
+    }
+  }
+  SECTION("Check eight digit words are converted.",
+          "[JSON][NumberScanner][Convert]") {
+    for (const std::string text :
+         {"00000000", "00000001", "12345678", "87654321", "99999999"}) {
+      REQUIRE(JSON_NumberScanner::parseEightDigits(JSON_NumberScanner::loadEight(
+                  text.data())) == std::stoul(text));
+    }
+  }
+}
+TEST_CASE("Check number scanner scans numbers.", "[JSON][NumberScanner]") {
+  JSON_NumberScanner::Number number;
+  SECTION("Scan integers.", "[JSON][NumberScanner][Integer]") {
+    for (const std::string text :
+         {"0", "-0", "7", "-42", "12345678", "1234567890123456",
+          "9223372036854775807", "-9223372036854775808"}) {
+      REQUIRE(JSON_NumberScanner::scan(text, number) == text.size());
+      REQUIRE(number.kind == JSON_NumberScanner::Kind::integer);
+      REQUIRE(number.integer == std::stoll(text));
+    }
+  }
+  SECTION("Scan floating point values and check they are correctly rounded.",
+          "[JSON][NumberScanner][FloatingPoint]") {
+    for (const std::string text :
+         {"0.0", "-0.5", "1e3", "1E-3", "2.5e+10", "-65.61361699999998",
+          "43.76453600000002", "0.1", "3.141592653589793238462643",
+          "1.7976931348623157e308", "5e-324", "123456789012345678901.5"}) {
+      REQUIRE(JSON_NumberScanner::scan(text, number) == text.size());
+      REQUIRE(number.kind == JSON_NumberScanner::Kind::floatingPoint);
+      REQUIRE(number.floatingPoint == std::strtod(text.c_str(), nullptr));
+    }
+  }
+  SECTION("Scan numbers followed by other characters.",
+          "[JSON][NumberScanner][Terminated]") {
+    REQUIRE(JSON_NumberScanner::scan("12345678901,2", number) == 11);
+    REQUIRE(number.integer == 12345678901);
+    REQUIRE(JSON_NumberScanner::scan("1.25]", number) == 4);
+    REQUIRE(number.floatingPoint == 1.25);
+    REQUIRE(JSON_NumberScanner::scan("-7 }", number) == 2);
+    REQUIRE(number.integer == -7);
+  }
+  SECTION("Leave numbers the scanner does not take to the general parser.",
+          "[JSON][NumberScanner][None]") {
+    for (const std::string text :
+         {"", "-", "+1", "01", "-00", "1.", ".5", "1e", "1e+", "1.2.3", "1-2",
+          "9223372036854775808", "-9223372036854775809",
+          "12345678901234567890", "1e400", "a"}) {
+      REQUIRE(JSON_NumberScanner::scan(text, number) == 0);
+    }
+  }
+}
+TEST_CASE("Check number scanner scans runs of numbers.",
+          "[JSON][NumberScanner]") {
+  std::vector<std::int64_t> integers;
+  std::vector<double> floatingPoints;
+  SECTION("Scan runs of integers and floating point values.",
+          "[JSON][NumberScanner][Run]") {
+    auto run = JSON_NumberScanner::scanRun("1, -2 ,\n30000000000\t]",
+                                           integers, floatingPoints);
+    REQUIRE(run.kind == JSON_NumberScanner::Kind::integer);
+    REQUIRE(run.length == 20);
+    REQUIRE(integers == std::vector<std::int64_t>{1, -2, 30000000000});
+    run = JSON_NumberScanner::scanRun("1.5,2e1]", integers, floatingPoints);
+    REQUIRE(run.kind == JSON_NumberScanner::Kind::floatingPoint);
+    REQUIRE(run.length == 7);
+    REQUIRE(integers.empty());
+    REQUIRE(floatingPoints == std::vector<double>{1.5, 20.0});
+  }
+  SECTION("Scan runs that are left to the general parser.",
+          "[JSON][NumberScanner][None]") {
+    for (const std::string text :
+         {"1,2.5]", "1,\"two\"]", "1,2", "1 2]", "1,2,]", "1,+2]", "1,[2]]"}) {
+      REQUIRE(JSON_NumberScanner::scanRun(text, integers, floatingPoints)
+                  .kind == JSON_NumberScanner::Kind::none);
+    }
+  }
+  SECTION("Narrow runs of floating point values to floats.",
+          "[JSON][NumberScanner][Float]") {
+    std::vector<float> floats;
+    REQUIRE(JSON_NumberScanner::toFloats({0.0, -65.61361699999998, 3e38},
+                                         floats));
+    REQUIRE(floats == std::vector<float>{0.0f, -65.61361699999998f, 3e38f});
+    for (const double value : {16777217.0, 1e-40, 3.4028235677973366e38}) {
+      REQUIRE_FALSE(JSON_NumberScanner::toFloats({0.5, value}, floats));
+    }
+    REQUIRE(JSON_NumberScanner::beyondFloat({1e300, -1e39}));
+    REQUIRE_FALSE(
+        JSON_NumberScanner::beyondFloat({1e300, 3.4028235677973366e38}));
+  }
+}
+TEST_CASE("Check scanned numbers parse the same as the general parser.",
+          "[JSON][NumberScanner]") {
+  const JSON json;
+  SECTION("Parse numbers and check their types.",
+          "[JSON][NumberScanner][Types]") {
+    json.parse(BufferSource{"[1,3000000000,2.5,-9223372036854775808]"});
+    const JNode &root = json.root();
+    REQUIRE(JNodeRef<JNodeNumber>(root[0]).number().isInt());
+    REQUIRE(JNodeRef<JNodeNumber>(root[1]).number().isLong());
+    REQUIRE(JNodeRef<JNodeNumber>(root[2]).number().isFloat());
+    REQUIRE(JNodeRef<JNodeNumber>(root[3]).number().getLLong() ==
+            std::numeric_limits<long long>::min());
+    json.parse(BufferSource{R"({"a":1,"b":-3000000000,"c":+5,"d":007})"});
+    REQUIRE(JNodeRef<JNodeNumber>(json["a"]).number().isInt());
+    REQUIRE(JNodeRef<JNodeNumber>(json["b"]).number().isLong());
+    REQUIRE(JNodeRef<JNodeNumber>(json["c"]).number().getInt() == 5);
+    REQUIRE(JNodeRef<JNodeNumber>(json["d"]).number().getInt() == 7);
+  }
+  SECTION("Parse generated documents from buffer and file and compare.",
+          "[JSON][NumberScanner][Generated]") {
+    for (auto shape : {JSON_Generator::Shape::numeric,
+                       JSON_Generator::Shape::records,
+                       JSON_Generator::Shape::wide}) {
+      const std::string jsonText{JSON_Generator{shape}.generate(64 * 1024)};
+      writeToFile(kGeneratedJSONFile, jsonText);
+      const JSON fromFile;
+      fromFile.parse(FileSource{kGeneratedJSONFile});
+      json.parse(BufferSource{jsonText});
+      BufferDestination bufferDestination;
+      BufferDestination fileDestination;
+      json.stringify(bufferDestination);
+      fromFile.stringify(fileDestination);
+      REQUIRE(bufferDestination.getBuffer() == fileDestination.getBuffer());
+      REQUIRE(json.validate(BufferSource{jsonText}));
+      std::filesystem::remove(kGeneratedJSONFile);
+    }
+  }
+  SECTION("Parse invalid numbers.", "[JSON][NumberScanner][Invalid]") {
+    for (const std::string jsonText :
+         {"[1,2,]", "[--1]", "[-]", "[1e]", "{\"a\":1.2.3}", "[1,2-]"}) {
+      REQUIRE_THROWS_AS(json.parse(BufferSource{jsonText}), JSONLib::Error);
+      REQUIRE_FALSE(json.validate(BufferSource{jsonText}));
+    }
+  }
+}
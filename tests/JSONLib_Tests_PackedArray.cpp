@@ -0,0 +1,193 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON packed (homogeneous numeric) array unit tests using
+// the Catch2 test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include <atomic>
+#include <thread>
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Check parse packs homogeneous numeric arrays.",
+          "[JSON][PackedArray]") {
+  const JSON json;
+  SECTION("Parse an integer array and check it is packed.",
+          "[JSON][PackedArray][Integer]") {
+    json.parse(BufferSource{"[1, -2 ,3000000000,4]"});
+    const auto &jNodeArray = JNodeRef<JNodeArray>(json.root());
+    REQUIRE(jNodeArray.packing() == JNodeArray::Packing::integer);
+    REQUIRE(jNodeArray.size() == 4);
+    REQUIRE(jNodeArray.integers().size() == 4);
+    REQUIRE(jNodeArray.integers()[2] == 3000000000);
+    REQUIRE(jNodeArray.floatingPoints().empty());
+  }
+  SECTION("Parse a float array and check it is packed.",
+          "[JSON][PackedArray][Float]") {
+    json.parse(BufferSource{"[-65.61361699999998,1e-3,0.5]"});
+    const auto &jNodeArray = JNodeRef<JNodeArray>(json.root());
+    REQUIRE(jNodeArray.packing() == JNodeArray::Packing::floatingPoint32);
+    REQUIRE(jNodeArray.floatingPoints32()[0] == -65.61361699999998f);
+    REQUIRE(jNodeArray.floatingPoints32()[1] == 1e-3f);
+    REQUIRE(jNodeArray.floatingPoints().empty());
+    REQUIRE(jNodeArray.integers().empty());
+  }
+  SECTION("Parse a double array and check it is packed.",
+          "[JSON][PackedArray][FloatingPoint]") {
+    json.parse(BufferSource{"[-6.5e300,1e-300,3.4e39]"});
+    const auto &jNodeArray = JNodeRef<JNodeArray>(json.root());
+    REQUIRE(jNodeArray.packing() == JNodeArray::Packing::floatingPoint);
+    REQUIRE(jNodeArray.floatingPoints()[0] == -6.5e300);
+    REQUIRE(jNodeArray.floatingPoints()[1] == 1e-300);
+    REQUIRE(jNodeArray.floatingPoints32().empty());
+  }
+  SECTION("Parse packed values with the types of unpacked values.",
+          "[JSON][PackedArray][Types]") {
+    for (const std::string jsonText :
+         {"0.5", "-65.61361699999998", "1e-300", "3.4e39", "1e-40", "3e38",
+          "16777217.0", "3.4028235677973366e38"}) {
+      json.parse(BufferSource{"[" + jsonText + "]"});
+      const JNodeNumeric packed{JNodeRef<JNodeArray>(json.root()).numeric(0)};
+      json.parse(BufferSource{"[" + jsonText + ",true]"});
+      const JNodeNumeric unpacked{JNodeRef<JNodeNumber>(json[0]).number()};
+      REQUIRE(packed.isFloat() == unpacked.isFloat());
+      REQUIRE(packed.isDouble() == unpacked.isDouble());
+      REQUIRE(packed.getString() == unpacked.getString());
+    }
+  }
+  SECTION("Parse arrays that are not packed.", "[JSON][PackedArray][None]") {
+    for (const std::string jsonText :
+         {"[]", "[1,2.5]", "[1.5,2]", "[1,\"two\",3]", "[\"one\",2,3]",
+          "[1,2,[3]]", "[0.5,1e+300]", "[1e400]"}) {
+      json.parse(BufferSource{jsonText});
+      REQUIRE(JNodeRef<JNodeArray>(json.root()).packing() ==
+              JNodeArray::Packing::none);
+      BufferDestination destination;
+      json.stringify(destination);
+      if (jsonText != "[1e400]") {
+        REQUIRE(destination.getBuffer() == jsonText);
+      }
+    }
+  }
+  SECTION("Parse nested packed arrays.", "[JSON][PackedArray][Nested]") {
+    json.parse(BufferSource{R"({"a":[[1,2],[3.5,4.5]],"b":[true,[5]]})"});
+    REQUIRE(JNodeRef<JNodeArray>(json["a"][0]).packing() ==
+            JNodeArray::Packing::integer);
+    REQUIRE(JNodeRef<JNodeArray>(json["a"][1]).packing() ==
+            JNodeArray::Packing::floatingPoint32);
+    REQUIRE(JNodeRef<JNodeArray>(json["b"][1]).packing() ==
+            JNodeArray::Packing::integer);
+  }
+  SECTION("Parse invalid numbers in a packed array.",
+          "[JSON][PackedArray][Invalid]") {
+    REQUIRE_THROWS_AS(json.parse(BufferSource{"[1,2,]"}), JSONLib::Error);
+    REQUIRE_THROWS_AS(json.parse(BufferSource{"[1,2"}), JSONLib::Error);
+    REQUIRE_THROWS_AS(json.parse(BufferSource{"[1 2]"}), JSONLib::Error);
+    REQUIRE_THROWS_AS(json.parse(BufferSource{"[1.2.3]"}), JSONLib::Error);
+  }
+}
+TEST_CASE("Check packed arrays can be accessed and stringified.",
+          "[JSON][PackedArray]") {
+  JSON json;
+  SECTION("Stringify packed arrays.", "[JSON][PackedArray][Stringify]") {
+    const std::string jsonText{
+        R"({"i":[1,-2,3000000000],"f":[-65.61362,0.001,2.0],"d":[1e+300,-2.5e-300]})"};
+    json.parse(BufferSource{jsonText});
+    BufferDestination destination;
+    json.stringify(destination);
+    REQUIRE(destination.getBuffer() == jsonText);
+  }
+  SECTION("Read packed array through a const reference without allocating.",
+          "[JSON][PackedArray][Const]") {
+    json.parse(BufferSource{"[1,3000000000,3]"});
+    const auto bytes = json.memoryUsage().total();
+    const JNode &root = json.root();
+    const auto &jNodeArray = JNodeRef<JNodeArray>(root);
+    REQUIRE(jNodeArray.numeric(0).isInt());
+    REQUIRE(jNodeArray.numeric(1).getLLong() == 3000000000);
+    REQUIRE_THROWS_AS(jNodeArray.numeric(3), JNode::Error);
+    REQUIRE_THROWS_AS(root[0], JNode::Error);
+    REQUIRE_THROWS_AS(jNodeArray.array(), JNode::Error);
+    REQUIRE(jNodeArray.packing() == JNodeArray::Packing::integer);
+    REQUIRE(json.memoryUsage().total() == bytes);
+  }
+  SECTION("Read packed array through a const JSON reference.",
+          "[JSON][PackedArray][ConstJSON]") {
+    json.parse(BufferSource{R"({"a":[1.5,2.5]})"});
+    const JSON &constJSON = json;
+    const auto &jNodeArray = JNodeRef<JNodeArray>(constJSON["a"]);
+    REQUIRE(jNodeArray.numeric(1).getDouble() == 2.5);
+    REQUIRE(jNodeArray.floatingPoints32()[0] == 1.5f);
+    REQUIRE_THROWS_AS(constJSON["a"][0], JNode::Error);
+    REQUIRE(jNodeArray.packing() == JNodeArray::Packing::floatingPoint32);
+  }
+  SECTION("Read a shared const packed array on several threads at once.",
+          "[JSON][PackedArray][Concurrency]") {
+    json.parse(BufferSource{"[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]"});
+    const auto &jNodeArray = JNodeRef<JNodeArray>(std::as_const(json).root());
+    std::vector<std::thread> workers;
+    std::atomic<int> mismatches{};
+    for (int thread = 0; thread < 8; thread++) {
+      workers.emplace_back([&jNodeArray, &mismatches, thread] {
+        for (int iteration = 0; iteration < 100; iteration++) {
+          for (std::size_t index = 0; index < 16; index++) {
+            const std::size_t entry = (index + thread) % 16;
+            if (jNodeArray.numeric(entry).getInt() !=
+                    static_cast<int>(entry) ||
+                jNodeArray.integers()[entry] !=
+                    static_cast<std::int64_t>(entry)) {
+              mismatches++;
+            }
+          }
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(jNodeArray.packing() == JNodeArray::Packing::integer);
+  }
+  SECTION("Modify packed array through indexing which unpacks it.",
+          "[JSON][PackedArray][Modify]") {
+    json.parse(BufferSource{"[1.5,2.5,3.5]"});
+    REQUIRE(JNodeRef<JNodeNumber>(json[1]).number().isFloat());
+    REQUIRE(JNodeRef<JNodeNumber>(json[1]).number().getDouble() == 2.5);
+    REQUIRE(JNodeRef<JNodeArray>(json.root()).packing() ==
+            JNodeArray::Packing::none);
+    json[1] = "two";
+    json[4] = 5;
+    BufferDestination destination;
+    json.stringify(destination);
+    REQUIRE(destination.getBuffer() == R"([1.5,"two",3.5,null,5])");
+  }
+  SECTION("Encode packed arrays to binary and decode them.",
+          "[JSON][PackedArray][Binary]") {
+    const std::string jsonText{
+        "[[1,2,3000000000],[4.5,5.5],[1e+300,2.5e-300]]"};
+    json.parse(BufferSource{jsonText});
+    BufferDestination binary;
+    json.stringifyBinary(binary);
+    const JSON decoded;
+    decoded.parseBinary(BufferSource{binary.getBuffer()});
+    BufferDestination destination;
+    decoded.stringify(destination);
+    REQUIRE(destination.getBuffer() == jsonText);
+    const JNode &root = decoded.root();
+    REQUIRE(JNodeRef<JNodeArray>(root[0]).packing() ==
+            JNodeArray::Packing::integer);
+    REQUIRE(JNodeRef<JNodeArray>(root[1]).packing() ==
+            JNodeArray::Packing::floatingPoint32);
+    REQUIRE(JNodeRef<JNodeArray>(root[2]).packing() ==
+            JNodeArray::Packing::floatingPoint);
+    REQUIRE(decoded.memoryUsage().nodes == json.memoryUsage().nodes);
+  }
+}
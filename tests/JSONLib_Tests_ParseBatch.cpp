@@ -0,0 +1,150 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON batch parse unit tests using the Catch2 test
+// framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_WorkStealingPool.hpp"
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Parse batches of JSON documents on the thread pool.",
+          "[JSON][ParseBatch]") {
+  SECTION("Run a batch of tasks and check every index is run exactly once.",
+          "[JSON][ParseBatch][Pool]") {
+    JSON_WorkStealingPool pool{4};
+    std::vector<std::atomic<int>> runs(1000);
+    pool.run(runs.size(), [&runs](std::size_t index) { runs[index]++; });
+    pool.run(runs.size(), [&runs](std::size_t index) { runs[index]++; });
+    REQUIRE(std::all_of(runs.begin(), runs.end(),
+                        [](const auto &count) { return (count == 2); }));
+  }
+  SECTION("Run a batch from within a batch task and check it completes.",
+          "[JSON][ParseBatch][Nested]") {
+    JSON_WorkStealingPool pool{4};
+    std::vector<std::atomic<int>> runs(100 * 100);
+    pool.run(100, [&](std::size_t outer) {
+      pool.run(100, [&](std::size_t inner) { runs[outer * 100 + inner]++; });
+    });
+    REQUIRE(std::all_of(runs.begin(), runs.end(),
+                        [](const auto &count) { return (count == 1); }));
+  }
+  SECTION("Run batches from several threads at once and check they complete.",
+          "[JSON][ParseBatch][Concurrent]") {
+    JSON_WorkStealingPool pool{4};
+    std::vector<std::atomic<int>> runs(1000);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++) {
+      threads.emplace_back([&] {
+        pool.run(runs.size(), [&runs](std::size_t index) { runs[index]++; });
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    REQUIRE(std::all_of(runs.begin(), runs.end(),
+                        [](const auto &count) { return (count == 4); }));
+  }
+  SECTION("Parse many small documents and check results are in order.",
+          "[JSON][ParseBatch][Order]") {
+    std::vector<std::unique_ptr<BufferSource>> buffers;
+    std::vector<ISource *> sources;
+    for (int document = 0; document < 500; document++) {
+      buffers.emplace_back(std::make_unique<BufferSource>(
+          R"({"id":)" + std::to_string(document) +
+          R"(,"name":"Document )" + std::to_string(document) +
+          R"(","values":[1,2,3]})"));
+      sources.push_back(buffers.back().get());
+    }
+    auto results = JSON::parseBatch(sources);
+    REQUIRE(results.size() == sources.size());
+    for (std::size_t document = 0; document < results.size(); document++) {
+      const JSON &json = *results[document].json;
+      REQUIRE(JNodeRef<JNodeNumber>(json["id"]).number().getInt() ==
+              static_cast<int>(document));
+      REQUIRE(JNodeRef<JNodeString>(json["name"]).toString() ==
+              "Document " + std::to_string(document));
+    }
+  }
+  SECTION("Parse test files as a batch and check against single parses.",
+          "[JSON][ParseBatch][Files]") {
+    const std::vector<std::string> fileNames{
+        "testfile001.json", "testfile002.json", "testfile003.json",
+        "testfile004.json", "testfile005.json"};
+    std::vector<std::unique_ptr<FileSource>> files;
+    std::vector<ISource *> sources;
+    for (const auto &fileName : fileNames) {
+      files.emplace_back(
+          std::make_unique<FileSource>(prefixTestDataPath(fileName)));
+      sources.push_back(files.back().get());
+    }
+    auto results = JSON::parseBatch(sources);
+    for (std::size_t file = 0; file < results.size(); file++) {
+      const JSON json;
+      json.parse(FileSource{prefixTestDataPath(fileNames[file])});
+      BufferDestination expected;
+      json.stringify(expected);
+      BufferDestination actual;
+      results[file].json->stringify(actual);
+      REQUIRE(actual.getBuffer() == expected.getBuffer());
+    }
+  }
+  SECTION("Re-parse a batch result and check its arena does not grow.",
+          "[JSON][ParseBatch][Arena]") {
+    CountingResource resource;
+    auto *previous = std::pmr::set_default_resource(&resource);
+    {
+      const std::string jsonText{R"({"values":[1,2,3],"name":"arena"})"};
+      BufferSource source{jsonText};
+      std::vector<ISource *> sources{&source};
+      auto results = JSON::parseBatch(sources);
+      const JSON &json = *results[0].json;
+      json.parse(BufferSource{jsonText});
+      const std::size_t bytesOutstanding = resource.bytesOutstanding;
+      const auto usage = json.memoryUsage();
+      REQUIRE(usage.allocatedBytes >= usage.total());
+      REQUIRE(usage.allocatedBytes <= bytesOutstanding);
+      for (int parse = 0; parse < 100; parse++) {
+        json.parse(BufferSource{jsonText});
+      }
+      REQUIRE(resource.bytesOutstanding == bytesOutstanding);
+      REQUIRE(json.memoryUsage().allocatedBytes == usage.allocatedBytes);
+      REQUIRE_THROWS(json.parse(BufferSource{R"({"one" : })"}));
+      REQUIRE(resource.bytesOutstanding == bytesOutstanding);
+      REQUIRE(JNodeRef<JNodeString>(json["name"]).toString() == "arena");
+    }
+    std::pmr::set_default_resource(previous);
+    REQUIRE(resource.bytesOutstanding == 0);
+  }
+  SECTION("Parse a batch containing invalid JSON and check only its result "
+          "holds the error.",
+          "[JSON][ParseBatch][Exceptions]") {
+    BufferSource first{R"([1,2,3])"};
+    BufferSource invalid{R"({"one" : })"};
+    BufferSource last{R"([4,5,6])"};
+    std::vector<ISource *> sources{&first, &invalid, &last};
+    auto results = JSON::parseBatch(sources);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0]);
+    REQUIRE(results[0].error == nullptr);
+    REQUIRE_FALSE(results[1]);
+    REQUIRE(results[1].message == "JSON Error: Syntax error detected.");
+    REQUIRE_THROWS_WITH(std::rethrow_exception(results[1].error),
+                        "JSON Error: Syntax error detected.");
+    REQUIRE(results[2]);
+    BufferDestination destination;
+    results[2].json->stringify(destination);
+    REQUIRE(destination.getBuffer() == "[4,5,6]");
+  }
+}
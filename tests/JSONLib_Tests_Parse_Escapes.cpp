@@ -81,7 +81,7 @@ TEST_CASE("JSON object for decoding of strings with escape characters.",
     BufferSource jsonSource{"\"Test String \\u0123 \""};
     json.parse(jsonSource);
     std::u8string expected{u8"Test String \u0123 "};
-    REQUIRE(JNodeRef<JNodeString>(json.root()).string() ==
+    REQUIRE(JNodeRef<JNodeString>(json.root()).toString() ==
             std::string{expected.begin(), expected.end()});
   }
   SECTION("Stringify JSON string with escapes '\\u0123 \\u0456' to buffer and "
@@ -90,7 +90,7 @@ TEST_CASE("JSON object for decoding of strings with escape characters.",
     BufferSource jsonSource{"\"Test String \\u0123 \\u0456 \""};
     json.parse(jsonSource);
     std::u8string expected{u8"Test String \u0123 \u0456 "};
-    REQUIRE(JNodeRef<JNodeString>(json.root()).string() ==
+    REQUIRE(JNodeRef<JNodeString>(json.root()).toString() ==
             std::string{expected.begin(), expected.end()});
   }
   SECTION("Stringify JSON string with escapes  '\\uD834\\uDD1E' to buffer and "
@@ -99,7 +99,7 @@ TEST_CASE("JSON object for decoding of strings with escape characters.",
     BufferSource jsonSource{"\"Test String  \\uD834\\uDD1E \""};
     json.parse(jsonSource);
     std::u8string expected{u8"Test String  \U0001D11E "};
-    REQUIRE(JNodeRef<JNodeString>(json.root()).string() ==
+    REQUIRE(JNodeRef<JNodeString>(json.root()).toString() ==
             std::string{expected.begin(), expected.end()});
   }
 }
\ No newline at end of file
@@ -8,10 +8,39 @@
 // Test definitions
 // =================
 #include "JSONLib_Tests.hpp"
+#include <thread>
 // ======================
 // JSON library namespace
 // ======================
 using namespace JSONLib;
+// =====================================================================
+// Translator that records whether it is called off its creating thread
+// =====================================================================
+class ThreadCheckingTranslator : public ITranslator {
+public:
+  std::string fromJSON(const std::string &jsonString) override {
+    check();
+    return (m_translator.fromJSON(jsonString));
+  }
+  std::string toJSON(const std::string &utf8String) override {
+    check();
+    return (m_translator.toJSON(utf8String));
+  }
+  bool validEscape(char escape) override {
+    return (m_translator.validEscape(escape));
+  }
+  bool otherThread{false};
+
+private:
+  void check() {
+    if (std::this_thread::get_id() != m_thread) {
+      otherThread = true;
+    }
+  }
+  std::thread::id m_thread{std::this_thread::get_id()};
+  JSON_Converter m_converter;
+  JSON_Translator m_translator{m_converter};
+};
 // ==========
 // Test cases
 // ==========
@@ -70,4 +99,88 @@ TEST_CASE("JSON object for stringification of a list of example JSON files.",
     REQUIRE(readFromFile(generatedFileName) ==
             stripWhiteSpace(json, jsonFileBuffer));
   }
+  SECTION("Stringify to buffer and check it is reserved up front with an "
+          "estimate that is not exceeded.",
+          "[JSON][Stringify][Reserve]") {
+    // Destination that records any reservation and bytes added
+    class ReserveDestination : public IDestination {
+    public:
+      void add(const std::string &bytes) override { added += bytes.size(); }
+      void add([[maybe_unused]] const char ch) override { added++; }
+      void clear() override { added = 0; }
+      void reserve(std::size_t size) override { reserved += size; }
+      [[nodiscard]] bool usesReserve() const override { return (true); }
+      std::size_t added{};
+      std::size_t reserved{};
+    };
+    json.parse(FileSource{prefixTestDataPath(testFile)});
+    ReserveDestination jsonDestination;
+    json.stringify(jsonDestination);
+    REQUIRE(jsonDestination.reserved >= jsonDestination.added);
+    REQUIRE(jsonDestination.reserved <= 2 * jsonDestination.added + 64);
+  }
+}
+// ========================================
+// Parallel stringification of large roots
+// ========================================
+TEST_CASE("Stringify large root containers in parallel and check result is "
+          "the same as a sequential stringify.",
+          "[JSON][Stringify][Parallel]") {
+  JSON json;
+  json.parse(BufferSource{"{}"});
+  SECTION("Stringify large array in parallel.",
+          "[JSON][Stringify][Parallel][Array]") {
+    std::string jsonString{"["};
+    for (int entry = 0; entry < 5000; entry++) {
+      jsonString += (entry != 0 ? "," : "");
+      jsonString += R"({"id":)" + std::to_string(entry) +
+                    R"(,"name":"Entry\t)" + std::to_string(entry) +
+                    R"(","values":[1,2.5,true,null]})";
+    }
+    json.parse(BufferSource{jsonString + "]"});
+    BufferDestination expected;
+    json.stringify(expected);
+    BufferDestination actual;
+    json.stringifyParallel(actual);
+    REQUIRE(actual.getBuffer() == expected.getBuffer());
+  }
+  SECTION("Stringify large object in parallel to a file.",
+          "[JSON][Stringify][Parallel][Object]") {
+    for (int entry = 0; entry < 5000; entry++) {
+      json["key" + std::to_string(entry)] = entry * 1.5;
+    }
+    BufferDestination expected;
+    json.stringify(expected);
+    const std::string generatedFileName{prefixTestDataPath(kGeneratedJSONFile)};
+    std::filesystem::remove(generatedFileName);
+    json.stringifyParallel(FileDestination{generatedFileName});
+    REQUIRE(readFromFile(generatedFileName) == expected.getBuffer());
+  }
+  SECTION("Stringify large array with a custom translator in parallel (done "
+          "sequentially).",
+          "[JSON][Stringify][Parallel][Translator]") {
+    auto *translator = new ThreadCheckingTranslator();
+    const JSON customJSON{translator};
+    std::string jsonString{"["};
+    for (int entry = 0; entry < 5000; entry++) {
+      jsonString += (entry != 0 ? "," : "");
+      jsonString += R"("Entry\t)" + std::to_string(entry) + R"(")";
+    }
+    customJSON.parse(BufferSource{jsonString + "]"});
+    BufferDestination expected;
+    customJSON.stringify(expected);
+    BufferDestination actual;
+    customJSON.stringifyParallel(actual);
+    REQUIRE(actual.getBuffer() == expected.getBuffer());
+    REQUIRE_FALSE(translator->otherThread);
+  }
+  SECTION("Stringify small document in parallel (done sequentially).",
+          "[JSON][Stringify][Parallel][Small]") {
+    json.parse(FileSource{prefixTestDataPath(kSingleJSONFile)});
+    BufferDestination expected;
+    json.stringify(expected);
+    BufferDestination actual;
+    json.stringifyParallel(actual);
+    REQUIRE(actual.getBuffer() == expected.getBuffer());
+  }
 }
@@ -0,0 +1,206 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON tape (read optimized flat document) unit tests
+// using the Catch2 test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Tape.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ===============
+// Local functions
+// ===============
+/// <summary>
+/// Recursively compare a JNode tree against a tape view.
+/// </summary>
+/// <param name="jNode">JNode to compare.</param>
+/// <param name="view">Tape view to compare.</param>
+/// <returns>==true then the same.</returns>
+static bool compareTape(const JNode &jNode, const JSON_Tape::View &view) {
+  if (jNode.getNodeType() != view.getNodeType()) {
+    return (false);
+  }
+  switch (jNode.getNodeType()) {
+  case JNodeType::object: {
+    if (static_cast<std::size_t>(JNodeRef<JNodeObject>(jNode).size()) !=
+        view.size()) {
+      return (false);
+    }
+    auto entry = view.begin();
+    for (auto &[key, jNodePtr] : JNodeRef<JNodeObject>(jNode).objects()) {
+      if (entry.key() != key || !compareTape(*jNodePtr, *entry)) {
+        return (false);
+      }
+      ++entry;
+    }
+    return (true);
+  }
+  case JNodeType::array: {
+    if (JNodeRef<JNodeArray>(jNode).size() != view.size()) {
+      return (false);
+    }
+    const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+    auto entry = view.begin();
+    if (jNodeArray.packing() != JNodeArray::Packing::none) {
+      for (std::size_t index = 0; index < jNodeArray.size(); index++) {
+        if ((*entry).getNodeType() != JNodeType::number ||
+            !equalFloatingPoint(jNodeArray.numeric(index).getDouble(),
+                                (*entry).getDouble(), 0.0001)) {
+          return (false);
+        }
+        ++entry;
+      }
+      return (true);
+    }
+    for (auto &jNodePtr : jNodeArray.array()) {
+      if (!compareTape(*jNodePtr, *entry)) {
+        return (false);
+      }
+      ++entry;
+    }
+    return (true);
+  }
+  case JNodeType::string:
+    return (JNodeRef<JNodeString>(jNode).string() == view.string());
+  case JNodeType::number:
+    return (equalFloatingPoint(
+        JNodeRef<JNodeNumber>(jNode).number().getDouble(), view.getDouble(),
+        0.0001));
+  case JNodeType::boolean:
+    return (JNodeRef<JNodeBoolean>(jNode).boolean() == view.boolean());
+  default:
+    return (true);
+  }
+}
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Parse JSON into a tape and access it through views.",
+          "[JSON][Tape]") {
+  JSON_Tape tape;
+  SECTION("Parse simple values.", "[JSON][Tape][Simple]") {
+    tape.parse(BufferSource{"\"test string\""});
+    REQUIRE(tape.root().getNodeType() == JNodeType::string);
+    REQUIRE(tape.root().string() == "test string");
+    tape.parse(BufferSource{"-45500"});
+    REQUIRE(tape.root().isLLong());
+    REQUIRE(tape.root().getLLong() == -45500);
+    tape.parse(BufferSource{"3.5"});
+    REQUIRE(tape.root().isDouble());
+    REQUIRE(tape.root().getDouble() == 3.5);
+    tape.parse(BufferSource{"true"});
+    REQUIRE(tape.root().boolean());
+    tape.parse(BufferSource{"null"});
+    REQUIRE(tape.root().getNodeType() == JNodeType::null);
+  }
+  SECTION("Parse object and access entries by key.",
+          "[JSON][Tape][Object]") {
+    tape.parse(BufferSource{
+        R"({"City":"Southampton","Population":500000,"Info":{"a":[1,2,3]}})"});
+    REQUIRE(tape.root().getNodeType() == JNodeType::object);
+    REQUIRE(tape.root().size() == 3);
+    REQUIRE(tape.root().contains("City"));
+    REQUIRE_FALSE(tape.root().contains("Town"));
+    REQUIRE(tape.root()["City"].string() == "Southampton");
+    REQUIRE(tape.root()["Population"].getLLong() == 500000);
+    REQUIRE(tape.root()["Info"]["a"][2].getLLong() == 3);
+    REQUIRE_THROWS_WITH(tape.root()["Town"],
+                        "JNode Error: Invalid key used to access object.");
+  }
+  SECTION("Parse array and check containers skip to their matching end.",
+          "[JSON][Tape][Array]") {
+    tape.parse(BufferSource{R"([[1,[2,3]],{"x":"y"},"z"])"});
+    REQUIRE(tape.root().size() == 3);
+    REQUIRE(tape.skip(0) == tape.tape().size());
+    REQUIRE(tape.root()[2].string() == "z");
+    REQUIRE(tape.root()[1]["x"].string() == "y");
+    REQUIRE_THROWS_WITH(tape.root()[3],
+                        "JNode Error: Invalid index used to access array.");
+  }
+  SECTION("Parse string with escapes and check they are translated.",
+          "[JSON][Tape][Escapes]") {
+    tape.parse(BufferSource{R"(["one\ttwo\u0041"])"});
+    REQUIRE(tape.root()[0].string() == "one\ttwoA");
+  }
+  SECTION("Parse keys and strings from buffer and file and check each is "
+          "held intact.",
+          "[JSON][Tape][Strings]") {
+    const std::string jsonText{
+        R"({"a\"b":"","plain":"text","c\\d":"e\"f\\g","":"last"})"};
+    for (const bool buffered : {true, false}) {
+      if (buffered) {
+        tape.parse(BufferSource{jsonText});
+      } else {
+        writeToFile(kGeneratedJSONFile, jsonText);
+        tape.parse(FileSource{kGeneratedJSONFile});
+        std::filesystem::remove(kGeneratedJSONFile);
+      }
+      REQUIRE(tape.root()["a\"b"].string().empty());
+      REQUIRE(tape.root()["plain"].string() == "text");
+      REQUIRE(tape.root()["c\\d"].string() == "e\"f\\g");
+      REQUIRE(tape.root()[""].string() == "last");
+    }
+  }
+  SECTION("Parse invalid JSON and check exception.",
+          "[JSON][Tape][Exceptions]") {
+    REQUIRE_THROWS_WITH(tape.parse(BufferSource{"{ \"one\" : }"}),
+                        "JSON Error: Syntax error detected.");
+    REQUIRE_THROWS_WITH(tape.parse(BufferSource{"[1,2"}),
+                        "JSON Error: Syntax error detected.");
+  }
+  SECTION("Parse invalid JSON and check the tape is left empty.",
+          "[JSON][Tape][Failed]") {
+    tape.parse(BufferSource{"[1,2]"});
+    REQUIRE_THROWS(tape.parse(BufferSource{"[1,[2,"}));
+    REQUIRE_THROWS_WITH(tape.root(), "JSON Error: No JSON has been parsed.");
+    REQUIRE(tape.tape().empty());
+    REQUIRE(tape.strings().empty());
+  }
+  SECTION("Parse decimal numbers and check they are held as exact doubles.",
+          "[JSON][Tape][Doubles]") {
+    const std::string jsonText{"[0.1,123456789.123,-65.61361699999998,"
+                               "+2.5,1e400,9223372036854775808]"};
+    for (const bool buffered : {true, false}) {
+      if (buffered) {
+        tape.parse(BufferSource{jsonText});
+      } else {
+        writeToFile(kGeneratedJSONFile, jsonText);
+        tape.parse(FileSource{kGeneratedJSONFile});
+        std::filesystem::remove(kGeneratedJSONFile);
+      }
+      REQUIRE(tape.root()[0].getDouble() == 0.1);
+      REQUIRE(tape.root()[1].getDouble() == 123456789.123);
+      REQUIRE(tape.root()[2].getDouble() == -65.61361699999998);
+      REQUIRE(tape.root()[3].getDouble() == 2.5);
+      REQUIRE(std::isinf(tape.root()[4].getDouble()));
+      REQUIRE(tape.root()[5].getDouble() == 9223372036854775808.0);
+    }
+  }
+  SECTION("Read doubles as long long and check out of range is reported.",
+          "[JSON][Tape][LLong]") {
+    tape.parse(BufferSource{"[-2.75,1e18,-9223372036854775808.0,1e400,"
+                            "-1e400,9223372036854775808.0]"});
+    REQUIRE(tape.root()[0].getLLong() == -2);
+    REQUIRE(tape.root()[1].getLLong() == 1000000000000000000);
+    REQUIRE(tape.root()[2].getLLong() ==
+            std::numeric_limits<long long>::min());
+    for (std::size_t index = 3; index < 6; index++) {
+      REQUIRE_THROWS_WITH(tape.root()[index].getLLong(),
+                          "JNode Error: Number out of range for a long long.");
+    }
+  }
+  SECTION("Parse test files into tape and check against JNode tree.",
+          "[JSON][Tape][Files]") {
+    TEST_FILE_LIST(testFile);
+    const JSON json;
+    json.parse(FileSource{prefixTestDataPath(testFile)});
+    tape.parse(FileSource{prefixTestDataPath(testFile)});
+    REQUIRE(compareTape(json.root(), tape.root()));
+  }
+}
@@ -0,0 +1,87 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON validation only parse unit tests using the Catch2
+// test framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include <atomic>
+#include <thread>
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Validate JSON without building a JNode tree.",
+          "[JSON][Validate]") {
+  const JSON json;
+  SECTION("Validate test files and check they are all valid.",
+          "[JSON][Validate][Files]") {
+    TEST_FILE_LIST(testFile);
+    const auto result = json.validate(FileSource{prefixTestDataPath(testFile)});
+    REQUIRE(result);
+    REQUIRE(result.message.empty());
+  }
+  SECTION("Validate invalid JSON and check error offset and message.",
+          "[JSON][Validate][Invalid]") {
+    auto result = json.validate(BufferSource{R"({ "one" : })"});
+    REQUIRE_FALSE(result);
+    REQUIRE(result.offset == 10);
+    REQUIRE(result.message == "JSON Error: Syntax error detected.");
+    result = json.validate(BufferSource{R"([1, 2, tru])"});
+    REQUIRE_FALSE(result);
+    REQUIRE(result.offset == 7);
+  }
+  SECTION("Validate the same inputs as parse and check they agree.",
+          "[JSON][Validate][Agree]") {
+    for (const std::string &jsonString : std::vector<std::string>{
+             R"({ "one" : "Apple })", R"({ "one" : z19034})",
+             R"({ "one" : 18987u3 })", R"({  : 89012 })",
+             R"({  "one" : 18987)", R"({{}})", R"([1,2,])",
+             R"([1.2.3])", R"([-])", R"([+45, -1e5, 3.5E-2, 1e5000])",
+             R"(["\t\n\"\\\/\p"])", R"(["A𝄞"])",
+             R"(["\uD834"])", R"(["\uDD1E"])", R"(["\uD834x"])",
+             R"(["\u00G1"])", R"(["\u12"])", R"({"a":true,"b":false})",
+             R"({"a":nul})", R"({"a":fals})", R"([] )", R"( "string" )",
+             R"({"key":"value",})", R"({"key" "value"})"}) {
+      bool parsed{true};
+      try {
+        json.parse(BufferSource{jsonString});
+      } catch ([[maybe_unused]] const std::exception &e) {
+        parsed = false;
+      }
+      INFO(jsonString);
+      REQUIRE(static_cast<bool>(json.validate(BufferSource{jsonString})) ==
+              parsed);
+    }
+  }
+  SECTION("Validate files through a shared const JSON on several threads "
+          "at once.",
+          "[JSON][Validate][Concurrency]") {
+    const std::string jsonText{
+        "[1.5, -2e10, 3000000000, {\"a\": 0.25}, [1E+2, -0.0], 42]"};
+    const std::string generatedFileName{prefixTestDataPath(kGeneratedJSONFile)};
+    writeToFile(generatedFileName, jsonText);
+    std::vector<std::thread> workers;
+    std::atomic<int> failures{};
+    for (int thread = 0; thread < 8; thread++) {
+      workers.emplace_back([&json, &generatedFileName, &failures] {
+        for (int iteration = 0; iteration < 100; iteration++) {
+          if (!json.validate(FileSource{generatedFileName})) {
+            failures++;
+          }
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    REQUIRE(failures == 0);
+    std::filesystem::remove(generatedFileName);
+  }
+}
@@ -0,0 +1,178 @@
+//
+// Unit Tests: JSON
+//
+// Description: JSON streaming writer unit tests using the Catch2 test
+// framework.
+//
+// ================
+// Test definitions
+// =================
+#include "JSONLib_Tests.hpp"
+#include "JSON_Writer.hpp"
+// ======================
+// JSON library namespace
+// ======================
+using namespace JSONLib;
+// ==========
+// Test cases
+// ==========
+TEST_CASE("Write JSON directly to a destination with JSONWriter.",
+          "[JSON][Writer]") {
+  BufferDestination jsonDestination;
+  JSONWriter writer{jsonDestination};
+  SECTION("Write simple values.", "[JSON][Writer][Simple]") {
+    writer.value(45500);
+    REQUIRE(writer.complete());
+    REQUIRE(jsonDestination.getBuffer() == "45500");
+  }
+  SECTION("Write characters and check they are strings not numbers.",
+          "[JSON][Writer][Character]") {
+    writer.beginObject().member("Grade", 'A').key("Marks").beginArray();
+    writer.value('"').value(static_cast<signed char>(65)).endArray();
+    writer.endObject();
+    REQUIRE(jsonDestination.getBuffer() ==
+            R"({"Grade":"A","Marks":["\"",65]})");
+  }
+  SECTION("Write string views and a null C string.",
+          "[JSON][Writer][StringView]") {
+    const std::string text{"Southampton Port"};
+    const char *none = nullptr;
+    writer.beginObject()
+        .member(std::string_view{text}.substr(0, 4), std::string_view{text})
+        .member("None", none);
+    writer.key(std::string_view{text}.substr(12)).value(text).endObject();
+    REQUIRE(jsonDestination.getBuffer() ==
+            R"({"Sout":"Southampton Port","None":null,)"
+            R"("Port":"Southampton Port"})");
+  }
+  SECTION("Check ending a container with none open is reported in all "
+          "builds.",
+          "[JSON][Writer][Unbalanced]") {
+    REQUIRE_THROWS_WITH(writer.endObject(),
+                        "JSONWriter Error: Mismatched end of object/array.");
+    writer.beginArray().endArray();
+    REQUIRE_THROWS_WITH(writer.endArray(),
+                        "JSONWriter Error: Mismatched end of object/array.");
+    REQUIRE(jsonDestination.getBuffer() == "[]");
+  }
+  SECTION("Write empty object and array.", "[JSON][Writer][Empty]") {
+    writer.beginArray().beginObject().endObject().beginArray().endArray();
+    REQUIRE_FALSE(writer.complete());
+    writer.endArray();
+    REQUIRE(writer.complete());
+    REQUIRE(jsonDestination.getBuffer() == "[{},[]]");
+  }
+  SECTION("Write nested object and array of all value types.",
+          "[JSON][Writer][Nested]") {
+    writer.beginObject()
+        .member("City", "Southampton")
+        .member("Population", 500000)
+        .member("Pi", 3.141)
+        .member("Port", true)
+        .member("Mayor", nullptr);
+    writer.key("Areas").beginArray();
+    writer.value("Shirley").value(1.0f).value(2ll).value(false);
+    writer.endArray().endObject();
+    REQUIRE(jsonDestination.getBuffer() ==
+            R"({"City":"Southampton","Population":500000,"Pi":3.141,)"
+            R"("Port":true,"Mayor":null,"Areas":["Shirley",1.0,2,false]})");
+  }
+  SECTION("Write strings and check they are escaped the same as stringify.",
+          "[JSON][Writer][Escapes]") {
+    const JSON json;
+    json.parse(BufferSource{
+        R"({"Escapes\n":"\t\"\\\b\f\r","Unicode":"é𝄞"})"});
+    BufferDestination expected;
+    json.stringify(expected);
+    writer.beginObject();
+    for (auto &[key, jNodePtr] : JNodeRef<JNodeObject>(json.root()).objects()) {
+      writer.member(key,
+                    JNodeRef<JNodeString>(*jNodePtr).toString());
+    }
+    writer.endObject();
+    REQUIRE(jsonDestination.getBuffer() == expected.getBuffer());
+  }
+  SECTION("Write a test file back out and check it is the same as stringify.",
+          "[JSON][Writer][Files]") {
+    const JSON json;
+    json.parse(FileSource{prefixTestDataPath(kSingleJSONFile)});
+    BufferDestination expected;
+    json.stringify(expected);
+    // Replay JNode tree through writer
+    auto writeNumber = [&](const JNodeNumeric &number) {
+      if (number.isInt()) {
+        writer.value(number.getInt());
+      } else if (number.isLong()) {
+        writer.value(number.getLong());
+      } else if (number.isLLong()) {
+        writer.value(number.getLLong());
+      } else if (number.isFloat()) {
+        writer.value(number.getFloat());
+      } else if (number.isDouble()) {
+        writer.value(number.getDouble());
+      } else {
+        writer.value(number.getLDouble());
+      }
+    };
+    std::function<void(const JNode &)> write = [&](const JNode &jNode) {
+      switch (jNode.getNodeType()) {
+      case JNodeType::object:
+        writer.beginObject();
+        for (auto &[key, jNodePtr] : JNodeRef<JNodeObject>(jNode).objects()) {
+          writer.key(key);
+          write(*jNodePtr);
+        }
+        writer.endObject();
+        break;
+      case JNodeType::array: {
+        const auto &jNodeArray = JNodeRef<JNodeArray>(jNode);
+        writer.beginArray();
+        if (jNodeArray.packing() != JNodeArray::Packing::none) {
+          for (std::size_t index = 0; index < jNodeArray.size(); index++) {
+            writeNumber(jNodeArray.numeric(index));
+          }
+        } else {
+          for (auto &jNodePtr : jNodeArray.array()) {
+            write(*jNodePtr);
+          }
+        }
+        writer.endArray();
+        break;
+      }
+      case JNodeType::string:
+        writer.value(JNodeRef<JNodeString>(jNode).toString());
+        break;
+      case JNodeType::number:
+        writeNumber(JNodeRef<JNodeNumber>(jNode).number());
+        break;
+      case JNodeType::boolean:
+        writer.value(JNodeRef<JNodeBoolean>(jNode).boolean());
+        break;
+      default:
+        writer.value(nullptr);
+      }
+    };
+    write(json.root());
+    REQUIRE(writer.complete());
+    REQUIRE(jsonDestination.getBuffer() == expected.getBuffer());
+  }
+#if !defined(NDEBUG)
+  SECTION("Check badly structured writes are reported in debug builds.",
+          "[JSON][Writer][Exceptions]") {
+    REQUIRE_THROWS_WITH(writer.key("outside"),
+                        "JSONWriter Error: Key written outside of an object.");
+    writer.beginObject();
+    REQUIRE_THROWS_WITH(writer.value(1),
+                        "JSONWriter Error: Object value written without a key.");
+    writer.key("one");
+    REQUIRE_THROWS_WITH(writer.key("two"),
+                        "JSONWriter Error: Object key written without a value.");
+    REQUIRE_THROWS_WITH(writer.endArray(),
+                        "JSONWriter Error: Mismatched end of object/array.");
+    writer.value(1).endObject();
+    REQUIRE_THROWS_WITH(
+        writer.value(2),
+        "JSONWriter Error: Only one top level value may be written.");
+  }
+#endif
+}